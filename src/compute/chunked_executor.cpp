@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Data-parallel executor that splits a range into cache-sized chunks
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/chunked_executor.h"
+
+#include <stdexcept>
+
+chunked_executor::chunked_executor(std::size_t const &chunk_size)
+{
+    if(chunk_size == 0)
+    {
+        throw std::invalid_argument("Chunk size must be greater than zero.");
+    }
+
+    this->chunk_size = chunk_size;
+}
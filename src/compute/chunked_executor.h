@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Data-parallel executor that splits a range into cache-sized chunks
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_CHUNKED_EXECUTOR_H
+#define COMPUTE_CHUNKED_EXECUTOR_H
+
+#include "core/parallel_for.h"
+
+#include <algorithm>
+#include <cstddef>
+
+/*
+    The element range [0, size) is cut into chunks of chunk_size elements.
+    Chunks are distributed between threads in contiguous blocks (static
+    schedule, see parallel_for), so every thread owns its own part of the
+    vectors and no two threads write the same element. All iterations of a chunk run before the
+    thread moves on to the next chunk, which keeps the chunk in cache.
+
+    function(begin, end) processes the elements [begin, end)
+*/
+class chunked_executor
+{
+public:
+    chunked_executor(std::size_t const &chunk_size);
+
+    template<typename function_type>
+    void run(std::size_t const &size, std::size_t const &iteration_count, function_type const &function) const;
+
+    std::size_t get_chunk_size() const
+    {
+        return chunk_size;
+    }
+
+private:
+    std::size_t chunk_size = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename function_type>
+void chunked_executor::run(std::size_t const &size, std::size_t const &iteration_count, function_type const &function) const
+{
+    parallel_for(
+        0,
+        size,
+        chunk_size,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t ic = 0; ic < iteration_count; ic++)
+            {
+                function(begin, end);
+            }
+        });
+}
+
+#endif // COMPUTE_CHUNKED_EXECUTOR_H
@@ -26,7 +26,127 @@
  */
 #include "compute/compute_cpu.h"
 
-#include "compute/fill_vectors.h"
+#include "platform/cpu_info.h"
+#include "platform/cpu_topology.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    /* Assumed last level cache size if it can't be detected */
+    std::size_t const default_last_level_cache_size = 8 * 1024 * 1024;
+
+    /* Assumed L2 cache size if it can't be detected */
+    std::size_t const default_l2_cache_size = 256 * 1024;
+
+    /* Assumed L1 data cache size if it can't be detected */
+    std::size_t const default_l1_cache_size = 32 * 1024;
+
+    std::size_t get_last_level_cache_size()
+    {
+        std::size_t size = cpu_info::instance().get_last_level_cache_size();
+        return (size != 0) ? size : default_last_level_cache_size;
+    }
+
+    std::size_t get_l2_cache_size()
+    {
+        std::size_t size = cpu_info::instance().get_l2_cache_size();
+        return (size != 0) ? size : default_l2_cache_size;
+    }
+
+    std::size_t get_l1_cache_size()
+    {
+        std::size_t size = cpu_info::instance().get_l1_cache_size();
+        return (size != 0) ? size : default_l1_cache_size;
+    }
+
+    /* Distance between a float result and the exact (double) value in units of the last place of the result */
+    double ulp_error(float const &result, double const &exact)
+    {
+        if(std::isnan(exact) || std::isinf(exact))
+        {
+            bool same = (std::isnan(exact) && std::isnan(result)) || (static_cast<double>(result) == exact);
+            return same ? 0.0 : std::numeric_limits<double>::infinity();
+        }
+
+        int exponent = 0;
+        std::frexp(static_cast<float>(exact), &exponent);
+
+        /* Subnormal results have a fixed ULP of 2^-149 */
+        double ulp = std::ldexp(1.0, std::max(exponent - std::numeric_limits<float>::digits, -149));
+
+        return std::fabs(static_cast<double>(result) - exact) / ulp;
+    }
+
+    /* Comma separated cpus in the order of the threads */
+    std::string get_cpu_list(std::vector<std::size_t> const &cpus)
+    {
+        std::string list;
+
+        for(std::size_t const &cpu : cpus)
+        {
+            list += (list.empty() ? "" : ",") + std::to_string(cpu);
+        }
+
+        return list;
+    }
+
+    /* Elements per reduction block, every block gives one partial result */
+    std::size_t const reduction_block_size = 65536;
+
+    /* Pairwise summation halves ranges down to this size */
+    std::size_t const pairwise_leaf_size = 1024;
+
+    /* The rounding error of the sum grows with log(size) instead of size */
+    float pairwise_reduce(simd_reduce_kernel kernel, float const *a, float const *b, std::size_t const &size)
+    {
+        if(size <= pairwise_leaf_size)
+        {
+            return kernel(a, b, size);
+        }
+
+        /* Halves stay multiples of the widest vector */
+        std::size_t half = (size / 2) & ~static_cast<std::size_t>(15);
+
+        return pairwise_reduce(kernel, a, b, half) + pairwise_reduce(kernel, a + half, (b != nullptr) ? b + half : nullptr, size - half);
+    }
+
+    /* Combine the partial results in a balanced tree (in place) */
+    float tree_combine(std::vector<float> &partials, float (*combine)(float, float))
+    {
+        std::size_t count = partials.size();
+
+        if(count == 0)
+        {
+            return 0.0f;
+        }
+
+        while(count > 1)
+        {
+            std::size_t half = count / 2;
+
+            for(std::size_t i = 0; i < half; i++)
+            {
+                partials[i] = combine(partials[2 * i], partials[(2 * i) + 1]);
+            }
+
+            if((count % 2) != 0)
+            {
+                partials[half] = partials[count - 1];
+            }
+
+            count = half + (count % 2);
+        }
+
+        return partials[0];
+    }
+} // namespace
 
 compute_cpu::compute_cpu(std::size_t const &vector_size, std::size_t const &iteration_count)
 {
@@ -34,68 +154,859 @@ compute_cpu::compute_cpu(std::size_t const &vector_size, std::size_t const &iter
     this->iteration_count = iteration_count;
 }
 
-std::string compute_cpu::get_string_name(operation_name name)
+void compute_cpu::set_execution_mode(cpu_execution_mode const &execution_mode)
+{
+    this->execution_mode = execution_mode;
+}
+
+void compute_cpu::set_chunk_size(std::size_t const &chunk_size)
+{
+    this->chunk_size = chunk_size;
+}
+
+void compute_cpu::set_log_accuracy(log_accuracy const &accuracy)
+{
+    this->accuracy = accuracy;
+}
+
+void compute_cpu::set_store_mode(cpu_store_mode const &store_mode)
+{
+    this->store_mode = store_mode;
+}
+
+void compute_cpu::set_element_types(std::vector<element_type> const &element_types)
+{
+    this->element_types = element_types;
+}
+
+void compute_cpu::set_reduction_mode(reduction_mode const &reduction)
+{
+    this->reduction = reduction;
+}
+
+void compute_cpu::set_operations(std::vector<std::string> const &operations)
 {
-    switch(name)
+    this->operations = operations;
+}
+
+std::string compute_cpu::get_element_type_name(element_type const &type)
+{
+    switch(type)
+    {
+        case ELEMENT_FLOAT:
+            return "float";
+        case ELEMENT_DOUBLE:
+            return "double";
+        case ELEMENT_INT32:
+            return "int32";
+        case ELEMENT_UINT8:
+            return "uint8";
+        case ELEMENT_FLOAT16:
+            return "fp16";
+        case ELEMENT_BFLOAT16:
+            return "bf16";
+        default:
+            return "unknown";
+    }
+}
+
+std::size_t compute_cpu::get_tile_size(std::size_t const &bytes_per_element)
+{
+    /* Half of L2 for the tile, the other half is left for the stack, the code and the prefetched lines */
+    std::size_t elements = get_l2_cache_size() / 2 / bytes_per_element;
+
+    /* Whole 64 byte cache lines of float */
+    elements -= elements % 16;
+
+    return std::max<std::size_t>(elements, 16);
+}
+
+std::size_t compute_cpu::get_chunk_size(std::size_t const &bytes_per_element)
+{
+    /* Set with -k */
+    if(chunk_size != 0)
     {
-        case ADDITION:
+        return chunk_size;
+    }
+
+    /* Half of L1 for the chunk, like the tiles of CPU_MODE_BLOCKED one level closer to the core */
+    std::size_t elements = get_l1_cache_size() / 2 / bytes_per_element;
+
+    /* Whole 64 byte cache lines of float */
+    elements -= elements % 16;
+
+    return std::max<std::size_t>(elements, 16);
+}
+
+bool compute_cpu::use_streaming_stores(std::size_t const &size, std::size_t const &bytes_per_element)
+{
+    switch(store_mode)
+    {
+        case STORE_MODE_STREAMING:
+            return true;
+        case STORE_MODE_AUTO:
         {
-            return "Addition";
-            break;
+            /*
+                Legacy mode sweeps over the whole vectors every iteration, chunked and blocked
+                modes reuse every chunk for all iterations, so only the chunk has to stay in the cache
+            */
+            std::size_t elements = size;
+
+            if(execution_mode == CPU_MODE_CHUNKED)
+                elements = std::min(get_chunk_size(bytes_per_element), size);
+            else if(execution_mode == CPU_MODE_BLOCKED)
+                elements = std::min(get_tile_size(bytes_per_element), size);
+
+            return (elements * bytes_per_element) > get_last_level_cache_size();
         }
-        case REMOVE:
+        case STORE_MODE_REGULAR:
+        default:
+            return false;
+    }
+}
+
+void compute_cpu::report_log_accuracy(float const *a, std::size_t const &size)
+{
+    simd_kernel_table const &table = simd_kernels::instance().get();
+
+    std::array<std::string, 3> names         = {"std::log (float)", "accurate", "fast"};
+    std::array<simd_unary_kernel, 3> kernels = {table.log, table.log_accurate, table.log_fast};
+
+    std::size_t const block_size = 4096;
+    std::size_t block_count      = (size + block_size - 1) / block_size;
+
+    for(std::size_t k = 0; k < kernels.size(); k++)
+    {
+        /* Per block results, reduced afterwards (the same with every parallel backend) */
+        std::vector<double> block_max(block_count, 0);
+        std::vector<double> block_sum(block_count, 0);
+        std::vector<std::size_t> block_over(block_count, 0);
+
+        parallel_for(
+            0,
+            size,
+            block_size,
+            [&](std::size_t begin, std::size_t end)
+            {
+                std::size_t block = begin / block_size;
+                std::size_t count = end - begin;
+
+                std::array<float, block_size> result;
+                kernels[k](a + begin, result.data(), count);
+
+                for(std::size_t i = 0; i < count; i++)
+                {
+                    double error = ulp_error(result[i], std::log(static_cast<double>(a[begin + i])));
+
+                    block_max[block] = std::max(block_max[block], error);
+                    block_sum[block] += error;
+                    block_over[block] += (error > 1.0) ? 1 : 0;
+                }
+            });
+
+        double max_error       = 0;
+        double sum_error       = 0;
+        std::size_t over_1_ulp = 0;
+
+        for(std::size_t block = 0; block < block_count; block++)
         {
-            return "Remove";
-            break;
+            max_error = std::max(max_error, block_max[block]);
+            sum_error += block_sum[block];
+            over_1_ulp += block_over[block];
         }
-        case MULTIPLE:
+
+        spdlog::info(
+            "Log accuracy ({}) against std::log over {} elements: max {:.3f} ULP, mean {:.4f} ULP, {} elements above 1 ULP",
+            names[k],
+            size,
+            max_error,
+            (size > 0) ? (sum_error / static_cast<double>(size)) : 0.0,
+            over_1_ulp);
+    }
+}
+
+void compute_cpu::measure_roofline()
+{
+    simd_kernel_table const &table = simd_kernels::instance().get();
+
+    spdlog::info("Measuring peaks on cpu ({})", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+
+    /* Vectors larger than the last level cache, streaming stores don't read c, so every element moves 12 bytes */
+    std::size_t size = std::max<std::size_t>(16 * 1024 * 1024, get_last_level_cache_size() / sizeof(float));
+
+    huge_page_vector<float> vec_a(size);
+    huge_page_vector<float> vec_b(size);
+    huge_page_vector<float> vec_c(size);
+
+    fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+    first_touch(vec_c.begin(), vec_c.end());
+
+    /* Best of the runs, the first one only warms up */
+    std::size_t const runs = 6;
+    double peak_bandwidth  = 0;
+
+    for(std::size_t r = 0; r < runs; r++)
+    {
+        execution_time et;
+        et.start();
+
+        parallel_for(
+            0,
+            size,
+            parallel_for_grain,
+            [&](std::size_t begin, std::size_t end)
+            {
+                table.addition_stream(&vec_a[begin], &vec_b[begin], &vec_c[begin], end - begin);
+            });
+
+        et.stop();
+
+        double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+        if((r > 0) && (seconds > 0))
         {
-            return "Multiple";
-            break;
+            peak_bandwidth = std::max(peak_bandwidth, static_cast<double>(3 * sizeof(float) * size) / seconds);
         }
-        case DIVIDE:
+    }
+
+    /* One multiply-add probe per hardware thread */
+    std::size_t threads          = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t const iterations = 1 << 24;
+    double peak_flops            = 0;
+
+    for(std::size_t r = 0; r < runs; r++)
+    {
+        std::vector<double> flops(threads, 0);
+
+        execution_time et;
+        et.start();
+
+        parallel_for(
+            0,
+            threads,
+            1,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for(std::size_t t = begin; t < end; t++)
+                {
+                    flops[t] = table.flops(iterations);
+                }
+            });
+
+        et.stop();
+
+        double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+        if((r > 0) && (seconds > 0))
         {
-            return "Divide";
-            break;
+            double sum = 0;
+
+            for(double const &f : flops)
+            {
+                sum += f;
+            }
+
+            peak_flops = std::max(peak_flops, sum / seconds);
         }
-        case EXPONENTIATION:
-        {
-            return "Exponentiation";
+    }
+
+    cpu_roofline = roofline("cpu", peak_bandwidth, peak_flops);
+    cpu_roofline.print_peaks();
+}
+
+void compute_cpu::report(
+    execution_time const &et,
+    cpu_execution_mode const &mode,
+    std::size_t const &size,
+    std::size_t const &bytes_per_element,
+    double const &flops_per_element)
+{
+    double seconds  = static_cast<double>(et.count_nanoseconds()) / 1e9;
+    double elements = static_cast<double>(size) * static_cast<double>(iteration_count);
+    double bytes    = elements * static_cast<double>(bytes_per_element);
+
+    if(seconds <= 0)
+    {
+        return;
+    }
+
+    spdlog::info("Throughput on cpu: {:.3e} (elements/s)", elements / seconds);
+    spdlog::info("Bandwidth on cpu: {:.2f} (GB/s)", bytes / seconds / 1e9);
+
+    /*
+        Chunks and tiles are reused from the cache by every iteration, the same with
+        whole vectors that fit in the last level cache, so memory sees a single pass
+    */
+    bool cache_resident = (mode == CPU_MODE_CHUNKED) || (mode == CPU_MODE_BLOCKED) || ((size * bytes_per_element) <= get_last_level_cache_size());
+    double memory_bytes = cache_resident ? (static_cast<double>(size) * static_cast<double>(bytes_per_element)) : bytes;
+
+    cpu_roofline.report(memory_bytes, elements * flops_per_element, seconds);
+}
+
+void compute_cpu::report_blocking(execution_time const &et_sweep, execution_time const &et_blocked, std::size_t const &size, std::size_t const &bytes_per_element)
+{
+    double sweep_seconds   = static_cast<double>(et_sweep.count_nanoseconds()) / 1e9;
+    double blocked_seconds = static_cast<double>(et_blocked.count_nanoseconds()) / 1e9;
+    double elements        = static_cast<double>(size) * static_cast<double>(iteration_count);
+    double bytes           = elements * static_cast<double>(bytes_per_element);
+
+    spdlog::info("Time to parallel compute on cpu with whole vector sweeps: {} (milliseconds)", et_sweep.count_milliseconds());
+
+    if((sweep_seconds <= 0) || (blocked_seconds <= 0))
+    {
+        return;
+    }
+
+    /* Sweeps over vectors that fit in the last level cache never reach DRAM */
+    bool dram_bound = (size * bytes_per_element) > get_last_level_cache_size();
+
+    spdlog::info(
+        "{} throughput on cpu: {:.3e} (elements/s), {:.2f} (GB/s)",
+        dram_bound ? "DRAM-bound" : "LLC-resident",
+        elements / sweep_seconds,
+        bytes / sweep_seconds / 1e9);
+    spdlog::info(
+        "Cache-resident throughput on cpu: {:.3e} (elements/s), {:.2f} (GB/s), {} KiB tiles",
+        elements / blocked_seconds,
+        bytes / blocked_seconds / 1e9,
+        get_tile_size(bytes_per_element) * bytes_per_element / 1024);
+    spdlog::info("Cache blocking speedup: {:.2f}x", sweep_seconds / blocked_seconds);
+}
+
+void compute_cpu::report_store_gain(execution_time const &et_regular, execution_time const &et_streaming, std::size_t const &size, std::size_t const &bytes_per_element)
+{
+    double regular_seconds   = static_cast<double>(et_regular.count_nanoseconds()) / 1e9;
+    double streaming_seconds = static_cast<double>(et_streaming.count_nanoseconds()) / 1e9;
+    double bytes             = static_cast<double>(size) * static_cast<double>(iteration_count) * static_cast<double>(bytes_per_element);
+
+    spdlog::info("Time to parallel compute on cpu with regular stores: {} (milliseconds)", et_regular.count_milliseconds());
+
+    if((regular_seconds <= 0) || (streaming_seconds <= 0))
+    {
+        return;
+    }
+
+    spdlog::info(
+        "Streaming stores bandwidth gain on cpu: {:.2f}x ({:.2f} GB/s regular, {:.2f} GB/s streaming)",
+        regular_seconds / streaming_seconds,
+        bytes / regular_seconds / 1e9,
+        bytes / streaming_seconds / 1e9);
+}
+
+void compute_cpu::report_conversion(execution_time const &et_conversion, execution_time const &et)
+{
+    double conversion_seconds = static_cast<double>(et_conversion.count_nanoseconds()) / 1e9;
+    double seconds            = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    spdlog::info("Time to convert on cpu without the operation: {} (milliseconds)", et_conversion.count_milliseconds());
+
+    if(seconds <= 0)
+    {
+        return;
+    }
+
+    spdlog::info("Conversions share on cpu: {:.1f}% of the operation time", 100.0 * conversion_seconds / seconds);
+}
+
+float compute_cpu::_reduce_blocks(
+    simd_reduce_kernel kernel,
+    float (*combine)(float, float),
+    reduction_mode const &mode,
+    float const *a,
+    float const *b,
+    std::size_t const &size,
+    std::size_t const &iterations)
+{
+    std::size_t blocks = (size + reduction_block_size - 1) / reduction_block_size;
+    std::vector<float> partials(blocks);
+    float result = 0.0f;
+
+    for(std::size_t ic = 0; ic < iterations; ic++)
+    {
+        parallel_for(
+            0,
+            blocks,
+            1,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for(std::size_t block = begin; block < end; block++)
+                {
+                    std::size_t first    = block * reduction_block_size;
+                    std::size_t count    = std::min(reduction_block_size, size - first);
+                    float const *block_b = (b != nullptr) ? b + first : nullptr;
+
+                    if(mode == REDUCTION_MODE_PAIRWISE)
+                        partials[block] = pairwise_reduce(kernel, a + first, block_b, count);
+                    else
+                        partials[block] = kernel(a + first, block_b, count);
+                }
+            });
+
+        result = tree_combine(partials, combine);
+    }
+
+    return result;
+}
+
+void compute_cpu::report_reduction_mode(reduction_mode const &mode, std::size_t const &size)
+{
+    std::size_t blocks = (size + reduction_block_size - 1) / reduction_block_size;
+
+    switch(mode)
+    {
+        case REDUCTION_MODE_PAIRWISE:
+            spdlog::info("Compute CPU reduction: pairwise ({} blocks of {} elements)", blocks, reduction_block_size);
             break;
-        }
-        case LOG:
-        {
-            return "Log";
+        case REDUCTION_MODE_KAHAN:
+            spdlog::info("Compute CPU reduction: kahan ({} blocks of {} elements)", blocks, reduction_block_size);
             break;
-        }
-        case UNKNOWN:
-        {
-            return "Unknown";
+        case REDUCTION_MODE_SIMPLE:
+        default:
+            spdlog::info("Compute CPU reduction: simple ({} blocks of {} elements)", blocks, reduction_block_size);
             break;
-        }
+    }
+}
+
+void compute_cpu::run_all()
+{
+    switch(execution_mode)
+    {
+        case CPU_MODE_CHUNKED:
+            if(chunk_size != 0)
+                spdlog::info("Compute CPU execution mode: chunked ({} elements per chunk)", chunk_size);
+            else
+                spdlog::info("Compute CPU execution mode: chunked (chunks of half of {} KiB L1 cache)", get_l1_cache_size() / 1024);
+            break;
+        case CPU_MODE_BLOCKED:
+            spdlog::info("Compute CPU execution mode: blocked (tiles of half of {} KiB L2 cache)", get_l2_cache_size() / 1024);
+            break;
+        case CPU_MODE_LEGACY:
         default:
-        {
-            return "UNKNOWN_OPERATION";
+            spdlog::info("Compute CPU execution mode: legacy (iterations are spread between threads)");
+            break;
+    }
+
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+            spdlog::info("Compute CPU parallel backend: thread pool ({} threads)", thread_pool::instance().get_thread_count());
+            break;
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+            spdlog::info("Compute CPU parallel backend: OpenMP");
+            break;
+    }
+
+    std::vector<std::size_t> cpus = get_parallel_affinity_cpus();
+
+    switch(settings::instance().get_affinity())
+    {
+        case AFFINITY_COMPACT:
+            spdlog::info("Compute CPU affinity: compact ({} nodes, cpus {})", cpu_topology::instance().get_node_count(), get_cpu_list(cpus));
+            break;
+        case AFFINITY_SCATTER:
+            spdlog::info("Compute CPU affinity: scatter ({} nodes, cpus {})", cpu_topology::instance().get_node_count(), get_cpu_list(cpus));
+            break;
+        case AFFINITY_EXPLICIT:
+            spdlog::info("Compute CPU affinity: explicit ({} nodes, cpus {})", cpu_topology::instance().get_node_count(), get_cpu_list(cpus));
+            break;
+        case AFFINITY_NONE:
+        default:
+            spdlog::info("Compute CPU affinity: none (threads are not pinned)");
+            break;
+    }
+
+    switch(accuracy)
+    {
+        case LOG_ACCURACY_FAST:
+            spdlog::info("Compute CPU logarithm: fast (vectorized, within 3 ULP)");
+            break;
+        case LOG_ACCURACY_ACCURATE:
+            spdlog::info("Compute CPU logarithm: accurate (vectorized, at most 1 ULP)");
+            break;
+        case LOG_ACCURACY_STD:
+        default:
+            spdlog::info("Compute CPU logarithm: std::log");
+            break;
+    }
+
+    switch(store_mode)
+    {
+        case STORE_MODE_STREAMING:
+            spdlog::info("Compute CPU stores: streaming");
+            break;
+        case STORE_MODE_AUTO:
+            spdlog::info("Compute CPU stores: auto (streaming when the working set exceeds {} KiB of last level cache)", get_last_level_cache_size() / 1024);
+            break;
+        case STORE_MODE_REGULAR:
+        default:
+            spdlog::info("Compute CPU stores: regular");
+            break;
+    }
+
+    switch(settings::instance().get_page_mode())
+    {
+        case PAGE_MODE_TRANSPARENT:
+            spdlog::info("Compute CPU pages: transparent huge pages (2 MiB aligned, madvise)");
+            break;
+        case PAGE_MODE_HUGETLB:
+            spdlog::info("Compute CPU pages: reserved huge pages (MAP_HUGETLB)");
+            break;
+        case PAGE_MODE_DEFAULT:
+        default:
+            spdlog::info("Compute CPU pages: regular (64 byte aligned)");
+            break;
+    }
+
+    switch(reduction)
+    {
+        case REDUCTION_MODE_PAIRWISE:
+            spdlog::info("Compute CPU reduction: pairwise");
             break;
+        case REDUCTION_MODE_KAHAN:
+            spdlog::info("Compute CPU reduction: kahan");
+            break;
+        case REDUCTION_MODE_SIMPLE:
+        default:
+            spdlog::info("Compute CPU reduction: simple");
+            break;
+    }
+
+    std::string selected;
+
+    for(std::string const &key : operations)
+    {
+        selected += (selected.empty() ? "" : ", ") + key;
+    }
+
+    spdlog::info("Compute CPU operations: {}", operations.empty() ? get_operation_key_list() : selected);
+
+    measure_roofline();
+
+    for(element_type const &type : element_types)
+    {
+        switch(type)
+        {
+            case ELEMENT_DOUBLE:
+                _run<double>(type);
+                break;
+            case ELEMENT_INT32:
+                _run<std::int32_t>(type);
+                break;
+            case ELEMENT_UINT8:
+                _run<std::uint8_t>(type);
+                break;
+            case ELEMENT_FLOAT16:
+                _run<float16>(type);
+                break;
+            case ELEMENT_BFLOAT16:
+                _run<bfloat16>(type);
+                break;
+            case ELEMENT_FLOAT:
+            default:
+                _run<float>(type);
+                break;
         }
     }
+}
+
+void compute_cpu::run_fusion()
+{
+    /* Uninitialized, every page is touched once by the parallel fill */
+    huge_page_vector<float> vec_a(vector_size);
+    huge_page_vector<float> vec_b(vector_size);
+    huge_page_vector<float> vec_c(vector_size);
+
+    fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+    first_touch(vec_c.begin(), vec_c.end());
 
-    return "UNKNOWN_OPERATION";
+    spdlog::info("Compute CPU fusion instruction set: {}", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+
+    expression_terminal a(vec_a.data());
+    expression_terminal b(vec_b.data());
+
+    /* The same composite as the exponentiation OpenCL kernels */
+    _fusion("(a + b) * (a + b)", (a + b) * (a + b), 2, vec_c);
+
+    _fusion("log(a * b + b) / (a + b)", log(a * b + b) / (a + b), 2, vec_c);
 }
 
-void compute_cpu::run_all()
+void compute_cpu::report_scaling_knee(std::vector<std::size_t> const &thread_counts, std::vector<double> const &bandwidth)
 {
-    std::vector<float> vec_a(vector_size, 0);
-    std::vector<float> vec_b(vector_size, 0);
-    std::vector<float> vec_c(vector_size, 0);
+    if(thread_counts.size() < 2)
+    {
+        return;
+    }
+
+    for(std::size_t i = 0; (i + 1) < thread_counts.size(); i++)
+    {
+        if(bandwidth[i + 1] < (bandwidth[i] * 1.1))
+        {
+            spdlog::info("Bandwidth on cpu saturates at {} threads ({:.2f} GB/s)", thread_counts[i], bandwidth[i]);
+            return;
+        }
+    }
+
+    spdlog::info("Bandwidth on cpu doesn't saturate up to {} threads", thread_counts.back());
+}
+
+void compute_cpu::run_scaling(std::string const &path)
+{
+    std::ofstream table(path);
+
+    if(!table)
+    {
+        throw std::runtime_error("Can't open the scaling table: " + path);
+    }
+
+    std::size_t initial_thread_count = get_parallel_thread_count();
+    std::size_t max_thread_count     = get_parallel_max_thread_count();
+
+    /* 1, 2, 4 ... and every available thread last */
+    std::vector<std::size_t> thread_counts;
+
+    for(std::size_t threads = 1; threads < max_thread_count; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+
+    thread_counts.push_back(max_thread_count);
+
+    spdlog::info("Compute CPU scaling: 1 to {} threads", max_thread_count);
+    spdlog::info("Compute CPU instruction set: {}", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+
+    /* Uninitialized, every page is touched once by the parallel fill (on every thread) */
+    huge_page_vector<float> vec_a(vector_size);
+    huge_page_vector<float> vec_b(vector_size);
+    huge_page_vector<float> vec_c(vector_size);
 
     fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+    first_touch(vec_c.begin(), vec_c.end());
+
+    table << "operation,threads,milliseconds,bandwidth_gbs,speedup,efficiency\n";
+
+    for_each_operation(
+        [&](auto op)
+        {
+            typedef decltype(op) operation;
+
+            if(!is_operation_selected(operations, operation::key))
+            {
+                return;
+            }
+
+            spdlog::info("Compute CPU application: {}", operation::name);
+
+            double bytes = static_cast<double>(vector_size) * static_cast<double>(iteration_count) * static_cast<double>(get_operation_streams<operation>() * sizeof(float));
+            double single_thread_seconds = 0;
+
+            std::vector<double> bandwidth;
+
+            /* Untimed warm-up, the first run would also count the kernel dispatch and the cold caches */
+            set_parallel_thread_count(max_thread_count);
+            _time_operation<operation>(vec_a.data(), vec_b.data(), vec_c.data(), vector_size);
+
+            for(std::size_t const &threads : thread_counts)
+            {
+                set_parallel_thread_count(threads);
+
+                execution_time et = _time_operation<operation>(vec_a.data(), vec_b.data(), vec_c.data(), vector_size);
+
+                double seconds = std::max(static_cast<double>(et.count_nanoseconds()) / 1e9, 1e-9);
+
+                if(threads == 1)
+                {
+                    single_thread_seconds = seconds;
+                }
+
+                double speedup    = single_thread_seconds / seconds;
+                double efficiency = speedup / static_cast<double>(threads);
+
+                bandwidth.push_back(bytes / seconds / 1e9);
+
+                spdlog::info(
+                    "Threads {:>3}: {:>10.3f} (milliseconds), {:>8.2f} (GB/s), speedup {:>6.2f}, efficiency {:>5.1f}%",
+                    threads,
+                    seconds * 1e3,
+                    bandwidth.back(),
+                    speedup,
+                    100.0 * efficiency);
 
-    _compute(operation_name::ADDITION, vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end(), vec_c.begin(), vec_c.end());
-    _compute(operation_name::REMOVE, vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end(), vec_c.begin(), vec_c.end());
-    _compute(operation_name::MULTIPLE, vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end(), vec_c.begin(), vec_c.end());
-    _compute(operation_name::DIVIDE, vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end(), vec_c.begin(), vec_c.end());
+                table << fmt::format("{},{},{:.3f},{:.3f},{:.3f},{:.3f}\n", operation::name, threads, seconds * 1e3, bandwidth.back(), speedup, efficiency);
+            }
 
-    _compute(operation_name::EXPONENTIATION, vec_a.begin(), vec_a.end(), vec_c.begin(), vec_c.end());
-    _compute(operation_name::LOG, vec_a.begin(), vec_a.end(), vec_c.begin(), vec_c.end());
+            report_scaling_knee(thread_counts, bandwidth);
+        });
+
+    set_parallel_thread_count(initial_thread_count);
+
+    spdlog::info("Scaling table is written to {}", path);
+}
+
+void compute_cpu::write_stream_inputs(std::string const &path_a, std::string const &path_b)
+{
+    stream_writer writer_a(path_a, stream_chunk_size);
+    stream_writer writer_b(path_b, stream_chunk_size);
+
+    for(std::size_t offset = 0; offset < vector_size; offset += stream_chunk_size)
+    {
+        std::size_t count = std::min(stream_chunk_size, vector_size - offset);
+
+        float *a = writer_a.acquire();
+        float *b = writer_b.acquire();
+
+        parallel_for(
+            0,
+            count,
+            parallel_for_grain,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for(std::size_t i = begin; i < end; i++)
+                {
+                    a[i] = fill_value_a<float>(offset + i);
+                    b[i] = fill_value_b<float>(offset + i);
+                }
+            });
+
+        writer_a.commit(count);
+        writer_b.commit(count);
+    }
+
+    writer_a.finish();
+    writer_b.finish();
+}
+
+void compute_cpu::report_stream(
+    execution_time const &et,
+    double const &compute_seconds,
+    double const &read_wait_seconds,
+    double const &write_wait_seconds,
+    std::size_t const &size,
+    std::size_t const &bytes_per_element)
+{
+    double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+    double bytes   = static_cast<double>(size) * static_cast<double>(bytes_per_element);
+
+    spdlog::info("Time to stream compute on cpu: {} (milliseconds)", et.count_milliseconds());
+
+    if((seconds <= 0) || (compute_seconds <= 0))
+    {
+        return;
+    }
+
+    spdlog::info("Stream throughput: {:.3f} GB/s end to end, {:.3f} GB/s computation alone", bytes / seconds / 1e9, bytes / compute_seconds / 1e9);
+    spdlog::info("Stream waits: {:.1f}% for reading, {:.1f}% for writing", read_wait_seconds / seconds * 100, write_wait_seconds / seconds * 100);
+
+    /* The side that waits is the faster one */
+    if((read_wait_seconds + write_wait_seconds) > (seconds / 2))
+    {
+        spdlog::info("Stream is bound by the files");
+    }
+    else
+    {
+        spdlog::info("Stream is bound by the computation");
+    }
+}
+
+void compute_cpu::run_stream(std::string const &directory)
+{
+    std::string path_a = directory + "/a.bin";
+    std::string path_b = directory + "/b.bin";
+    std::string path_c = directory + "/c.bin";
+
+    if((stream_reader::get_file_size(path_a) == 0) || (stream_reader::get_file_size(path_b) == 0))
+    {
+        execution_time et;
+        et.start();
+
+        write_stream_inputs(path_a, path_b);
+
+        et.stop();
+
+        spdlog::info("Stream inputs are written to {} ({} elements, {} milliseconds)", directory, vector_size, et.count_milliseconds());
+    }
+
+    spdlog::info(
+        "Stream: {} elements, chunks of {} elements, every operation writes {}",
+        std::min(stream_reader::get_file_size(path_a), stream_reader::get_file_size(path_b)),
+        stream_chunk_size,
+        path_c);
+
+    for_each_operation(
+        [&](auto op)
+        {
+            typedef decltype(op) operation;
+
+            if(is_operation_selected(operations, operation::key))
+            {
+                _stream<operation>(path_a, path_b, path_c);
+            }
+        });
+}
+
+void compute_cpu::run_dataset(std::string const &path_a, std::string const &path_b, std::string const &path_c)
+{
+    dataset_file file_a(path_a);
+    std::unique_ptr<dataset_file> file_b;
+    std::unique_ptr<dataset_file> file_c;
+
+    spdlog::info("Compute CPU dataset a: {} ({} elements, {})", path_a, file_a.get_size(), file_a.has_header() ? "header" : "raw float");
+
+    /*
+        Real integer data divides by zero (SIGFPE), overflows signed arithmetic and takes
+        the logarithm of zero, the synthetic test data is made to avoid all of that
+    */
+    if((file_a.get_type() == ELEMENT_INT32) || (file_a.get_type() == ELEMENT_UINT8))
+    {
+        throw std::runtime_error("Datasets must be float, double, fp16 or bf16: " + path_a);
+    }
+
+    if(!path_b.empty())
+    {
+        file_b = std::make_unique<dataset_file>(path_b);
+        spdlog::info("Compute CPU dataset b: {} ({} elements, {})", path_b, file_b->get_size(), file_b->has_header() ? "header" : "raw float");
+    }
+
+    if(!path_c.empty())
+    {
+        /* The output is truncated, an input mapped from the same file would lose its data */
+        if(file_a.is_same_file(path_c) || (file_b && file_b->is_same_file(path_c)))
+        {
+            throw std::runtime_error("The output dataset is an input dataset: " + path_c);
+        }
+
+        file_c = std::make_unique<dataset_file>(path_c, file_a.get_type(), file_a.get_size());
+        spdlog::info("Compute CPU dataset output: {}", path_c);
+    }
+
+    measure_roofline();
+
+    switch(file_a.get_type())
+    {
+        case ELEMENT_DOUBLE:
+            _run_dataset<double>(file_a, file_b.get(), file_c.get());
+            break;
+        case ELEMENT_FLOAT16:
+            _run_dataset<float16>(file_a, file_b.get(), file_c.get());
+            break;
+        case ELEMENT_BFLOAT16:
+            _run_dataset<bfloat16>(file_a, file_b.get(), file_c.get());
+            break;
+        case ELEMENT_FLOAT:
+        default:
+            _run_dataset<float>(file_a, file_b.get(), file_c.get());
+            break;
+    }
+
+    if(file_c)
+    {
+        execution_time et;
+        et.start();
+
+        file_c->sync();
+
+        et.stop();
+
+        spdlog::info("Time to write the dataset output: {} (milliseconds)", et.count_milliseconds());
+    }
 }
\ No newline at end of file
@@ -27,13 +27,43 @@
 #ifndef COMPUTE_COMPUTE_CPU_H
 #define COMPUTE_COMPUTE_CPU_H
 
+#include "compute/chunked_executor.h"
+#include "compute/expression.h"
+#include "compute/fill_vectors.h"
+#include "compute/half_types.h"
+#include "compute/operations.h"
+#include "compute/roofline.h"
+#include "compute/simd/simd_kernels.h"
 #include "core/execution_time.h"
+#include "core/huge_page_allocator.h"
+#include "core/parallel_for.h"
+#include "core/settings.h"
+#include "io/dataset_file.h"
 #include "io/log/logger.h"
+#include "io/stream_reader.h"
+#include "io/stream_writer.h"
+#include "platform/perf_counters.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <exception>
+#include <iterator>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+/* Iterators over contiguous float storage can be handed to the SIMD kernels as raw pointers */
+template<typename iterator_type>
+struct is_simd_iterator
+    : std::integral_constant<
+          bool,
+          std::is_same<iterator_type, float *>::value || std::is_same<iterator_type, std::vector<float>::iterator>::value ||
+              std::is_same<iterator_type, huge_page_vector<float>::iterator>::value>
+{
+};
+
 class compute_cpu
 {
 public:
@@ -41,23 +71,183 @@ public:
 
     void run_all();
 
-    enum operation_name
-    {
-        ADDITION,
-        REMOVE,
-        MULTIPLE,
-        DIVIDE,
-        EXPONENTIATION,
-        LOG,
-        UNKNOWN
-    };
+    /* Compare fused (expression templates) and unfused evaluation of chained operations */
+    void run_fusion();
+
+    /*
+        Rerun every float operation at 1, 2, 4 ... N threads, print the speedup, the parallel
+        efficiency and the thread count where bandwidth saturates and write the table as CSV to path
+    */
+    void run_scaling(std::string const &path);
+
+    /*
+        Run every float operation in one pass over a.bin and b.bin (raw float) in directory,
+        chunk by chunk with reading ahead and writing c.bin back on their own threads, and
+        print the end to end throughput. The inputs are written first (vector_size elements)
+        if they don't exist, their size is not limited by the memory
+    */
+    void run_stream(std::string const &directory);
+
+    /*
+        Run every operation on mapped dataset files (see io/dataset_file.h) instead of the
+        test data, path_b (binary operations and dot) and path_c are optional (empty).
+        The element type comes from the header of path_a, path_c gets the result of
+        the last elementwise operation
+    */
+    void run_dataset(std::string const &path_a, std::string const &path_b, std::string const &path_c);
+
+    void set_execution_mode(cpu_execution_mode const &execution_mode);
+    void set_chunk_size(std::size_t const &chunk_size);
+    void set_log_accuracy(log_accuracy const &accuracy);
+    void set_store_mode(cpu_store_mode const &store_mode);
+    void set_element_types(std::vector<element_type> const &element_types);
+    void set_reduction_mode(reduction_mode const &reduction);
+
+    /* Keys of the operations to run (see compute/operations.h), every operation if empty */
+    void set_operations(std::vector<std::string> const &operations);
 
 private:
-    std::string get_string_name(operation_name name);
+    std::string get_element_type_name(element_type const &type);
+
+    /* Allocate and fill vectors of data_type and run every operation on them */
+    template<typename data_type>
+    void _run(element_type const &type);
+
+    /* Run every operation on the mapped elements of a (and b), c is anonymous memory without file_c */
+    template<typename data_type>
+    void _run_dataset(dataset_file const &file_a, dataset_file const *file_b, dataset_file *file_c);
+
+    /* Should the result be written with streaming stores (see cpu_store_mode) */
+    bool use_streaming_stores(std::size_t const &size, std::size_t const &bytes_per_element);
+
+    /* Elements per L2 tile in CPU_MODE_BLOCKED, bytes_per_element counts every read and written element */
+    std::size_t get_tile_size(std::size_t const &bytes_per_element);
+
+    /* Elements per chunk in CPU_MODE_CHUNKED, the one set with set_chunk_size or an L1 sized chunk when it is 0 */
+    std::size_t get_chunk_size(std::size_t const &bytes_per_element);
+
+    /*
+        Run body(begin, end) iteration_count times over [0, size) in the given execution mode
+        CPU_MODE_LEGACY: iterations are spread between threads, every iteration covers the whole range
+        CPU_MODE_CHUNKED: the range is spread between threads in chunks of get_chunk_size (chunked_executor)
+        CPU_MODE_BLOCKED: the same with L2 sized tiles instead of chunks
+        CPU_MODE_SWEEP: iterations run one after another, each one spreads the whole range between threads
+    */
+    template<typename function_type>
+    void _execute(cpu_execution_mode const &mode, std::size_t const &size, std::size_t const &bytes_per_element, function_type const &body);
+
+    template<typename expression_type>
+    void _fusion(std::string const &name, expression<expression_type> const &e, std::size_t const &inputs, huge_page_vector<float> &vec_c);
+
+    /* Compare the vectorized logarithms with std::log over the input and print the error in ULP */
+    void report_log_accuracy(float const *a, std::size_t const &size);
+
+    /* Measure peak bandwidth (streaming addition) and peak FLOP rate (multiply-add chains on every thread) */
+    void measure_roofline();
+
+    /*
+        Print achieved throughput and the roofline, bytes_per_element counts every read and written element
+        mode is how the run reused the data (CPU_MODE_LEGACY and CPU_MODE_SWEEP: every iteration sweeps the whole vectors)
+    */
+    void report(
+        execution_time const &et,
+        cpu_execution_mode const &mode,
+        std::size_t const &size,
+        std::size_t const &bytes_per_element,
+        double const &flops_per_element);
+
+    /* Print whole vector sweeps (DRAM-bound) and L2 tiles (cache-resident) throughput side by side */
+    void report_blocking(execution_time const &et_sweep, execution_time const &et_blocked, std::size_t const &size, std::size_t const &bytes_per_element);
+
+    /* Print the bandwidth gain of streaming stores over regular stores */
+    void report_store_gain(execution_time const &et_regular, execution_time const &et_streaming, std::size_t const &size, std::size_t const &bytes_per_element);
+
+    /* Print the share of the conversions in the run time of an operation on half precision elements */
+    void report_conversion(execution_time const &et_conversion, execution_time const &et);
+
+    /* Elements of half precision vectors converted to float at once, the float blocks stay in L1 */
+    static constexpr std::size_t conversion_block_size = 1024;
+
+    /* Conversion kernels of float16 or bfloat16 */
+    template<typename half_type>
+    simd_to_float_kernel get_to_float_kernel();
+
+    template<typename half_type>
+    simd_from_float_kernel get_from_float_kernel();
+
+    /*
+        c = kernel(a, b) over half precision elements: blocks of a and b are converted
+        to float, computed with the float kernel and converted back.
+        Without a kernel only the conversions run (a is converted back into c)
+    */
+    template<typename half_type>
+    void _convert_binary(simd_binary_kernel kernel, half_type const *a, half_type const *b, half_type *c, std::size_t const &size);
+
+    template<typename half_type>
+    void _convert_unary(simd_unary_kernel kernel, half_type const *a, half_type *c, std::size_t const &size);
+
+    /*
+        Reduce a (a and b for two input reductions) iteration_count times. Fixed size blocks
+        are reduced in parallel and their partial results are combined in a tree, so the
+        result doesn't depend on the thread count
+    */
+    template<typename operation>
+    void _reduce(float const *a, float const *b, std::size_t const &size);
+
+    /* The reduction_mode of the operation, minimum and maximum always reduce simply */
+    template<typename operation>
+    reduction_mode get_reduction_mode();
+
+    /* The iterations of _reduce without logging, returns the result of the last one */
+    template<typename operation>
+    float _reduce_iterations(float const *a, float const *b, std::size_t const &size);
+
+    /* Reduce blocks of a (and b) with the kernel and combine the partial results iterations times, see _reduce */
+    float _reduce_blocks(
+        simd_reduce_kernel kernel,
+        float (*combine)(float, float),
+        reduction_mode const &mode,
+        float const *a,
+        float const *b,
+        std::size_t const &size,
+        std::size_t const &iterations);
+
+    /* Print the reduction mode and the blocks of a reduction of size elements */
+    void report_reduction_mode(reduction_mode const &mode, std::size_t const &size);
+
+    /* Run the float operation once as the benchmark does (without reports) and return its time */
+    template<typename operation>
+    execution_time _time_operation(float const *a, float const *b, float *c, std::size_t const &size);
+
+    /* Print where adding threads stops adding bandwidth (less than 10% gain per step) */
+    void report_scaling_knee(std::vector<std::size_t> const &thread_counts, std::vector<double> const &bandwidth);
+
+    /* Elements per chunk of run_stream, a multiple of the reduction blocks */
+    static constexpr std::size_t stream_chunk_size = 8 * 1024 * 1024;
+
+    /* Write vector_size elements of the test data to path_a and path_b chunk by chunk */
+    void write_stream_inputs(std::string const &path_a, std::string const &path_b);
+
+    /* One pass of the operation over the files, c is written to path_c (reductions print their result) */
+    template<typename operation>
+    void _stream(std::string const &path_a, std::string const &path_b, std::string const &path_c);
+
+    /* Print the end to end throughput of a stream, the computation alone and the time spent waiting for the files */
+    void report_stream(
+        execution_time const &et,
+        double const &compute_seconds,
+        double const &read_wait_seconds,
+        double const &write_wait_seconds,
+        std::size_t const &size,
+        std::size_t const &bytes_per_element);
 
-    template<typename iterator_type>
+    /* Print the reduction result and its error against a double precision reference */
+    template<typename operation>
+    void report_reduction(float const &result, float const *a, float const *b, std::size_t const &size);
+
+    /* c = operation(a, b) or c = operation(a), b is not used by unary operations */
+    template<typename operation, typename iterator_type>
     void _compute(
-        operation_name name,
         iterator_type start_iterator_a,
         iterator_type end_iterator_a,
         iterator_type start_iterator_b,
@@ -65,168 +255,645 @@ private:
         iterator_type start_iterator_c,
         iterator_type end_iterator_c);
 
-    template<typename iterator_type>
-    void _compute(operation_name name, iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_c, iterator_type end_iterator_c);
-
-    std::size_t vector_size     = 102400000;
-    std::size_t iteration_count = 100;
+    std::size_t vector_size           = 102400000;
+    std::size_t iteration_count       = 100;
+    cpu_execution_mode execution_mode = CPU_MODE_LEGACY;
+    std::size_t chunk_size            = 0;
+    log_accuracy accuracy             = LOG_ACCURACY_ACCURATE;
+    cpu_store_mode store_mode         = STORE_MODE_REGULAR;
+    std::vector<element_type> element_types {ELEMENT_FLOAT};
+    reduction_mode reduction          = REDUCTION_MODE_SIMPLE;
+    std::vector<std::string> operations;
+    roofline cpu_roofline;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template<typename iterator_type>
-void compute_cpu::_compute(
-    operation_name name,
-    iterator_type start_iterator_a,
-    iterator_type end_iterator_a,
-    iterator_type start_iterator_b,
-    iterator_type end_iterator_b,
-    iterator_type start_iterator_c,
-    iterator_type end_iterator_c)
+template<typename data_type>
+void compute_cpu::_run(element_type const &type)
 {
-    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
-    typedef typename std::iterator_traits<iterator_type> data_size;
+    spdlog::info("Compute CPU element type: {} ({} bytes)", get_element_type_name(type), sizeof(data_type));
+
+    perf_counters counters;
+    counters.start();
+
+    execution_time et_setup;
+    et_setup.start();
+
+    /* Uninitialized, every page is touched once by the parallel fill */
+    huge_page_vector<data_type> vec_a(vector_size);
+    huge_page_vector<data_type> vec_b(vector_size);
+    huge_page_vector<data_type> vec_c(vector_size);
+
+    fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+    first_touch(vec_c.begin(), vec_c.end());
+
+    et_setup.stop();
+
+    counters.stop();
+
+    spdlog::info("Time to allocate and fill vectors on cpu: {} (milliseconds)", et_setup.count_milliseconds());
+    spdlog::info("Page counters on cpu: {}", counters.to_string());
+
+    for_each_operation(
+        [&](auto op)
+        {
+            typedef decltype(op) operation;
 
-    std::size_t size_of_a = sizeof(data_type) * (end_iterator_a - start_iterator_a);
-    std::size_t size_of_b = sizeof(data_type) * (end_iterator_b - start_iterator_b);
-    std::size_t size_of_c = sizeof(data_type) * (end_iterator_c - start_iterator_c);
+            if(!is_operation_selected(operations, operation::key))
+            {
+                return;
+            }
+
+            if constexpr(operation::kind != OPERATION_REDUCTION)
+            {
+                _compute<operation>(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end(), vec_c.begin(), vec_c.end());
+            }
+            else if constexpr(std::is_same<data_type, float>::value)
+            {
+                /* The reductions are float only */
+                _reduce<operation>(vec_a.data(), vec_b.data(), vec_a.size());
+            }
+
+            /* The vectorized logarithms are float only */
+            if constexpr(std::is_same<operation, operation_log>::value && std::is_same<data_type, float>::value)
+            {
+                report_log_accuracy(vec_a.data(), vec_a.size());
+            }
+        });
+}
+
+template<typename data_type>
+void compute_cpu::_run_dataset(dataset_file const &file_a, dataset_file const *file_b, dataset_file *file_c)
+{
+    std::size_t size = file_a.get_size();
 
-    std::size_t size_a = sizeof(data_size) * (end_iterator_a - start_iterator_a);
-    std::size_t size_b = sizeof(data_size) * (end_iterator_b - start_iterator_b);
-    std::size_t size_c = sizeof(data_size) * (end_iterator_c - start_iterator_c);
+    spdlog::info("Compute CPU element type: {} ({} bytes)", get_element_type_name(file_a.get_type()), sizeof(data_type));
 
-    if((size_of_a != size_of_b) && (size_of_a != size_of_c))
+    if((file_b != nullptr) && ((file_b->get_type() != file_a.get_type()) || (file_b->get_size() < size)))
     {
-        throw std::logic_error("Iterators are not equal.");
+        throw std::runtime_error("Dataset b must have the element type of a and at least as many elements");
     }
 
-    spdlog::info("Compute CPU application: {}", get_string_name(name));
+    /* The engines read the mapped pages directly, the input mappings are never written */
+    data_type *a = file_a.data<data_type>();
+    data_type *b = (file_b != nullptr) ? file_b->data<data_type>() : a;
 
-    execution_time et;
-    et.start();
+    /* Uninitialized, only used without an output file */
+    huge_page_vector<data_type> vec_c((file_c != nullptr) ? 0 : size);
+    first_touch(vec_c.begin(), vec_c.end());
 
-    switch(name)
-    {
-        case ADDITION:
+    data_type *c = (file_c != nullptr) ? file_c->data<data_type>() : vec_c.data();
+
+    for_each_operation(
+        [&](auto op)
         {
-#pragma omp parallel for
-            for(std::size_t ic = 0; ic < iteration_count; ic++)
+            typedef decltype(op) operation;
+
+            if(!is_operation_selected(operations, operation::key))
             {
-                for(std::size_t i = 0; i < size_c; i++)
-                {
-                    start_iterator_c[i] = start_iterator_a[i] + start_iterator_b[i];
-                }
+                return;
             }
-            break;
-        }
-        case REMOVE:
-        {
-#pragma omp parallel for
-            for(std::size_t ic = 0; ic < iteration_count; ic++)
+
+            constexpr bool needs_b = (operation::kind == OPERATION_BINARY) || ((operation::kind == OPERATION_REDUCTION) && (get_operation_streams<operation>() > 1));
+
+            if(needs_b && (file_b == nullptr))
             {
-                for(std::size_t i = 0; i < size_c; i++)
-                {
-                    start_iterator_c[i] = start_iterator_a[i] - start_iterator_b[i];
-                }
+                spdlog::info("Compute CPU application: {} (skipped, needs dataset b)", operation::name);
+                return;
+            }
+
+            if constexpr(operation::kind != OPERATION_REDUCTION)
+            {
+                _compute<operation>(a, a + size, b, b + size, c, c + size);
+            }
+            else if constexpr(std::is_same<data_type, float>::value)
+            {
+                /* The reductions are float only */
+                _reduce<operation>(a, b, size);
+            }
+
+            /* The vectorized logarithms are float only */
+            if constexpr(std::is_same<operation, operation_log>::value && std::is_same<data_type, float>::value)
+            {
+                report_log_accuracy(a, size);
             }
+        });
+}
+
+template<typename half_type>
+simd_to_float_kernel compute_cpu::get_to_float_kernel()
+{
+    simd_kernel_table const &table = simd_kernels::instance().get();
+
+    if constexpr(std::is_same<half_type, float16>::value)
+        return table.float16_to_float;
+    else
+        return table.bfloat16_to_float;
+}
+
+template<typename half_type>
+simd_from_float_kernel compute_cpu::get_from_float_kernel()
+{
+    simd_kernel_table const &table = simd_kernels::instance().get();
+
+    if constexpr(std::is_same<half_type, float16>::value)
+        return table.float_to_float16;
+    else
+        return table.float_to_bfloat16;
+}
+
+template<typename half_type>
+void compute_cpu::_convert_binary(simd_binary_kernel kernel, half_type const *a, half_type const *b, half_type *c, std::size_t const &size)
+{
+    simd_to_float_kernel to_float     = get_to_float_kernel<half_type>();
+    simd_from_float_kernel from_float = get_from_float_kernel<half_type>();
+
+    alignas(64) float block_a[conversion_block_size];
+    alignas(64) float block_b[conversion_block_size];
+    alignas(64) float block_c[conversion_block_size];
+
+    for(std::size_t i = 0; i < size; i += conversion_block_size)
+    {
+        std::size_t count = std::min(conversion_block_size, size - i);
+
+        to_float(reinterpret_cast<std::uint16_t const *>(a + i), block_a, count);
+        to_float(reinterpret_cast<std::uint16_t const *>(b + i), block_b, count);
+
+        if(kernel != nullptr)
+        {
+            kernel(block_a, block_b, block_c, count);
+            from_float(block_c, reinterpret_cast<std::uint16_t *>(c + i), count);
+        }
+        else
+        {
+            from_float(block_a, reinterpret_cast<std::uint16_t *>(c + i), count);
+        }
+    }
+}
+
+template<typename half_type>
+void compute_cpu::_convert_unary(simd_unary_kernel kernel, half_type const *a, half_type *c, std::size_t const &size)
+{
+    simd_to_float_kernel to_float     = get_to_float_kernel<half_type>();
+    simd_from_float_kernel from_float = get_from_float_kernel<half_type>();
+
+    alignas(64) float block_a[conversion_block_size];
+    alignas(64) float block_c[conversion_block_size];
+
+    for(std::size_t i = 0; i < size; i += conversion_block_size)
+    {
+        std::size_t count = std::min(conversion_block_size, size - i);
+
+        to_float(reinterpret_cast<std::uint16_t const *>(a + i), block_a, count);
+
+        if(kernel != nullptr)
+        {
+            kernel(block_a, block_c, count);
+            from_float(block_c, reinterpret_cast<std::uint16_t *>(c + i), count);
+        }
+        else
+        {
+            from_float(block_a, reinterpret_cast<std::uint16_t *>(c + i), count);
+        }
+    }
+}
+
+template<typename function_type>
+void compute_cpu::_execute(cpu_execution_mode const &mode, std::size_t const &size, std::size_t const &bytes_per_element, function_type const &body)
+{
+    switch(mode)
+    {
+        case CPU_MODE_CHUNKED:
+        {
+            chunked_executor executor(get_chunk_size(bytes_per_element));
+            executor.run(size, iteration_count, body);
             break;
         }
-        case MULTIPLE:
+        case CPU_MODE_BLOCKED:
         {
-#pragma omp parallel for
-            for(std::size_t ic = 0; ic < iteration_count; ic++)
-            {
-                for(std::size_t i = 0; i < size_c; i++)
-                {
-                    start_iterator_c[i] = start_iterator_a[i] * start_iterator_b[i];
-                }
-            }
+            chunked_executor executor(get_tile_size(bytes_per_element));
+            executor.run(size, iteration_count, body);
             break;
         }
-        case DIVIDE:
+        case CPU_MODE_SWEEP:
         {
-#pragma omp parallel for
             for(std::size_t ic = 0; ic < iteration_count; ic++)
             {
-                for(std::size_t i = 0; i < size_c; i++)
-                {
-                    start_iterator_c[i] = start_iterator_a[i] / start_iterator_b[i];
-                }
+                parallel_for(0, size, parallel_for_grain, body);
             }
             break;
         }
+        case CPU_MODE_LEGACY:
         default:
         {
-            throw std::invalid_argument("Operation name type not found.");
+            parallel_for(
+                0,
+                iteration_count,
+                1,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for(std::size_t ic = begin; ic < end; ic++)
+                    {
+                        body(0, size);
+                    }
+                });
             break;
         }
     }
+}
+
+template<typename operation, typename iterator_type>
+void compute_cpu::_compute(
+    iterator_type start_iterator_a,
+    iterator_type end_iterator_a,
+    iterator_type start_iterator_b,
+    iterator_type end_iterator_b,
+    iterator_type start_iterator_c,
+    iterator_type end_iterator_c)
+{
+    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
+
+    constexpr bool binary                   = (operation::kind == OPERATION_BINARY);
+    constexpr std::size_t bytes_per_element = get_operation_streams<operation>() * sizeof(data_type);
+
+    std::size_t size = end_iterator_c - start_iterator_c;
+
+    if(((end_iterator_a - start_iterator_a) != (end_iterator_c - start_iterator_c)) || (binary && ((end_iterator_b - start_iterator_b) != (end_iterator_c - start_iterator_c))))
+    {
+        throw std::logic_error("Iterators are not equal.");
+    }
+
+    spdlog::info("Compute CPU application: {}", operation::name);
+
+    /* Only the SIMD kernels have streaming stores */
+    bool streaming = is_simd_iterator<iterator_type>::value && use_streaming_stores(size, bytes_per_element);
+
+    auto kernel = operation::kernel(simd_kernels::instance().get(), streaming, accuracy);
+
+    /* Contiguous float data goes through the dispatched SIMD kernels */
+    if(is_simd_iterator<iterator_type>::value)
+    {
+        spdlog::info("Compute CPU instruction set: {}", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+        spdlog::info("Compute CPU stores: {}", streaming ? "streaming" : "regular");
+    }
+
+    /* Half precision elements are converted to float for the same kernels */
+    if(is_half_type<data_type>::value)
+    {
+        spdlog::info("Compute CPU instruction set: {} (through float)", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+    }
+
+    auto body = [&](std::size_t begin, std::size_t end)
+    {
+        if constexpr(is_simd_iterator<iterator_type>::value && binary)
+        {
+            kernel(&start_iterator_a[begin], &start_iterator_b[begin], &start_iterator_c[begin], end - begin);
+        }
+        else if constexpr(is_simd_iterator<iterator_type>::value)
+        {
+            kernel(&start_iterator_a[begin], &start_iterator_c[begin], end - begin);
+        }
+        else if constexpr(is_half_type<data_type>::value && binary)
+        {
+            _convert_binary(kernel, &start_iterator_a[begin], &start_iterator_b[begin], &start_iterator_c[begin], end - begin);
+        }
+        else if constexpr(is_half_type<data_type>::value)
+        {
+            _convert_unary(kernel, &start_iterator_a[begin], &start_iterator_c[begin], end - begin);
+        }
+        else
+        {
+            /* Local copies, stores of char sized elements could alias the captured iterators and stop vectorization */
+            iterator_type a = start_iterator_a;
+            iterator_type b = start_iterator_b;
+            iterator_type c = start_iterator_c;
+
+            for(std::size_t i = begin; i < end; i++)
+            {
+                if constexpr(binary)
+                    c[i] = operation::template apply<data_type>(a[i], b[i]);
+                else
+                    c[i] = operation::template apply<data_type>(a[i]);
+            }
+        }
+    };
+
+    perf_counters counters;
+    counters.start();
+
+    execution_time et;
+    et.start();
+
+    _execute(execution_mode, size, bytes_per_element, body);
+
+    et.stop();
+
+    counters.stop();
+
+    spdlog::info("Time to parallel compute on cpu: {} (nanoseconds)", et.count_nanoseconds());
+    spdlog::info("Time to parallel compute on cpu: {} (milliseconds)", et.count_milliseconds());
+    spdlog::info("Page counters on cpu: {}", counters.to_string());
+
+    /* Integer operations don't count as floating point operations */
+    report(et, execution_mode, size, bytes_per_element, std::is_integral<data_type>::value ? 0 : operation::flops);
+
+    /* Run again as whole vector sweeps (every thread streams its part of the vectors) to compare with the cache-resident tiles */
+    if(execution_mode == CPU_MODE_BLOCKED)
+    {
+        execution_time et_sweep;
+        et_sweep.start();
+
+        _execute(CPU_MODE_SWEEP, size, bytes_per_element, body);
+
+        et_sweep.stop();
+
+        report_blocking(et_sweep, et, size, bytes_per_element);
+    }
+
+    /* Run again with regular stores to show what streaming stores gain */
+    if(streaming)
+    {
+        kernel = operation::kernel(simd_kernels::instance().get(), false, accuracy);
+
+        execution_time et_regular;
+        et_regular.start();
+
+        _execute(execution_mode, size, bytes_per_element, body);
+
+        et_regular.stop();
+
+        report_store_gain(et_regular, et, size, bytes_per_element);
+    }
+
+    /* Run again with the conversions only to show what they cost */
+    if constexpr(is_half_type<data_type>::value)
+    {
+        kernel = nullptr;
+
+        execution_time et_conversion;
+        et_conversion.start();
+
+        _execute(execution_mode, size, bytes_per_element, body);
+
+        et_conversion.stop();
+
+        report_conversion(et_conversion, et);
+    }
+}
+
+template<typename operation>
+reduction_mode compute_cpu::get_reduction_mode()
+{
+    /* Minimum and maximum are exact, they don't need another summation */
+    return operation::summation ? reduction : REDUCTION_MODE_SIMPLE;
+}
+
+template<typename operation>
+float compute_cpu::_reduce_iterations(float const *a, float const *b, std::size_t const &size)
+{
+    reduction_mode mode = get_reduction_mode<operation>();
+
+    simd_reduce_kernel kernel = operation::kernel(simd_kernels::instance().get(), mode == REDUCTION_MODE_KAHAN);
+
+    return operation::finish(_reduce_blocks(kernel, &operation::combine, mode, a, (operation::inputs > 1) ? b : nullptr, size, iteration_count));
+}
+
+template<typename operation>
+void compute_cpu::_reduce(float const *a, float const *b, std::size_t const &size)
+{
+    spdlog::info("Compute CPU application: {}", operation::name);
+
+    report_reduction_mode(get_reduction_mode<operation>(), size);
+
+    spdlog::info("Compute CPU instruction set: {}", simd_kernels::get_isa_name(simd_kernels::instance().get_isa()));
+
+    execution_time et;
+    et.start();
+
+    float result = _reduce_iterations<operation>(a, b, size);
 
     et.stop();
 
     spdlog::info("Time to parallel compute on cpu: {} (nanoseconds)", et.count_nanoseconds());
     spdlog::info("Time to parallel compute on cpu: {} (milliseconds)", et.count_milliseconds());
+
+    /* Every iteration sweeps the whole vectors */
+    report(et, CPU_MODE_LEGACY, size, get_operation_streams<operation>() * sizeof(float), operation::flops);
+
+    report_reduction<operation>(result, a, b, size);
 }
 
-template<typename iterator_type>
-void compute_cpu::_compute(operation_name name, iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_c, iterator_type end_iterator_c)
+template<typename operation>
+void compute_cpu::report_reduction(float const &result, float const *a, float const *b, std::size_t const &size)
 {
-    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
-    typedef typename std::iterator_traits<iterator_type> data_size;
+    /* Serial reference in double precision */
+    double exact = operation::identity;
 
-    std::size_t size_of_a = sizeof(data_type) * (end_iterator_a - start_iterator_a);
-    std::size_t size_of_c = sizeof(data_type) * (end_iterator_c - start_iterator_c);
+    for(std::size_t i = 0; i < size; i++)
+    {
+        exact = operation::accumulate(exact, a[i], (operation::inputs > 1) ? b[i] : 0.0f);
+    }
 
-    std::size_t size_a = sizeof(data_size) * (end_iterator_a - start_iterator_a);
-    std::size_t size_c = sizeof(data_size) * (end_iterator_c - start_iterator_c);
+    exact = operation::finish(exact);
 
-    if(size_of_a != size_of_c)
+    double error = std::fabs(static_cast<double>(result) - exact);
+
+    if(exact != 0.0)
     {
-        throw std::logic_error("Iterators are not equal.");
+        error /= std::fabs(exact);
     }
 
-    spdlog::info("Compute CPU application: {}", get_string_name(name));
+    spdlog::info("Reduction result on cpu: {:.9e} (double precision reference {:.9e}, relative error {:.3e})", result, exact, error);
+}
+
+template<typename operation>
+execution_time compute_cpu::_time_operation(float const *a, float const *b, float *c, std::size_t const &size)
+{
+    constexpr std::size_t bytes_per_element = get_operation_streams<operation>() * sizeof(float);
+
+    execution_time et;
+
+    if constexpr(operation::kind == OPERATION_REDUCTION)
+    {
+        et.start();
+        _reduce_iterations<operation>(a, b, size);
+        et.stop();
+    }
+    else
+    {
+        auto kernel = operation::kernel(simd_kernels::instance().get(), use_streaming_stores(size, bytes_per_element), accuracy);
+
+        et.start();
+        _execute(
+            execution_mode,
+            size,
+            bytes_per_element,
+            [&](std::size_t begin, std::size_t end)
+            {
+                if constexpr(operation::kind == OPERATION_BINARY)
+                    kernel(a + begin, b + begin, c + begin, end - begin);
+                else
+                    kernel(a + begin, c + begin, end - begin);
+            });
+        et.stop();
+    }
+
+    return et;
+}
+
+template<typename expression_type>
+void compute_cpu::_fusion(std::string const &name, expression<expression_type> const &e, std::size_t const &inputs, huge_page_vector<float> &vec_c)
+{
+    spdlog::info("Compute CPU fusion: {} ({} operations)", name, expression_type::operations);
+
+    std::vector<huge_page_vector<float>> workspace;
+
+    /* Warm up, the unfused evaluation also allocates its temporary vectors here */
+    evaluate(vec_c.data(), vec_c.size(), e, accuracy);
+    evaluate_unfused(vec_c.data(), vec_c.size(), e, workspace, accuracy);
+
+    execution_time et_fused;
+    et_fused.start();
+
+    for(std::size_t ic = 0; ic < iteration_count; ic++)
+    {
+        evaluate(vec_c.data(), vec_c.size(), e, accuracy);
+    }
+
+    et_fused.stop();
+
+    execution_time et_unfused;
+    et_unfused.start();
+
+    for(std::size_t ic = 0; ic < iteration_count; ic++)
+    {
+        evaluate_unfused(vec_c.data(), vec_c.size(), e, workspace, accuracy);
+    }
+
+    et_unfused.stop();
+
+    double elements        = static_cast<double>(vec_c.size()) * static_cast<double>(iteration_count);
+    double fused_seconds   = static_cast<double>(et_fused.count_nanoseconds()) / 1e9;
+    double unfused_seconds = static_cast<double>(et_unfused.count_nanoseconds()) / 1e9;
+
+    /* Compulsory traffic: every input is read once and the result is written once */
+    double useful_bytes = elements * static_cast<double>((inputs + 1) * sizeof(float));
+
+    /* Traffic of the unfused evaluation: every operation reads its operands and writes a temporary vector */
+    double unfused_bytes = elements * static_cast<double>(expression_type::streams * sizeof(float));
+
+    spdlog::info("Time to fused compute on cpu: {} (milliseconds)", et_fused.count_milliseconds());
+    spdlog::info("Time to unfused compute on cpu: {} (milliseconds)", et_unfused.count_milliseconds());
+
+    if((fused_seconds <= 0) || (unfused_seconds <= 0))
+    {
+        return;
+    }
+
+    spdlog::info("Fused bandwidth on cpu: {:.2f} (GB/s, 1 pass)", useful_bytes / fused_seconds / 1e9);
+    spdlog::info(
+        "Unfused bandwidth on cpu: {:.2f} (GB/s, {} passes, {:.2f} GB/s of actual traffic)",
+        useful_bytes / unfused_seconds / 1e9,
+        expression_type::operations,
+        unfused_bytes / unfused_seconds / 1e9);
+    spdlog::info("Fusion speedup: {:.2f}x", unfused_seconds / fused_seconds);
+}
+
+template<typename operation>
+void compute_cpu::_stream(std::string const &path_a, std::string const &path_b, std::string const &path_c)
+{
+    constexpr bool reduction = (operation::kind == OPERATION_REDUCTION);
+    constexpr bool binary    = (operation::kind == OPERATION_BINARY) || (reduction && (get_operation_streams<operation>() > 1));
+
+    spdlog::info("Stream application: {}", operation::name);
+
+    std::vector<std::string> inputs = {path_a};
+
+    if(binary)
+    {
+        inputs.push_back(path_b);
+    }
+
+    double compute_seconds    = 0;
+    double write_wait_seconds = 0;
 
     execution_time et;
     et.start();
 
-    switch(name)
+    stream_reader reader(inputs, stream_chunk_size);
+
+    if constexpr(reduction)
     {
-        case EXPONENTIATION:
+        reduction_mode mode       = get_reduction_mode<operation>();
+        simd_reduce_kernel kernel = operation::kernel(simd_kernels::instance().get(), mode == REDUCTION_MODE_KAHAN);
+
+        float result = 0.0f;
+
+        while(stream_chunk const *chunk = reader.acquire())
         {
-#pragma omp parallel for
-            for(std::size_t ic = 0; ic < iteration_count; ic++)
-            {
-                for(std::size_t i = 0; i < size_c; i++)
-                {
-                    start_iterator_c[i] = start_iterator_a[i] * start_iterator_a[i];
-                }
-            }
-            break;
+            execution_time et_compute;
+            et_compute.start();
+
+            float partial = _reduce_blocks(kernel, &operation::combine, mode, chunk->data[0].data(), binary ? chunk->data[1].data() : nullptr, chunk->count, 1);
+
+            /* The chunks are combined in order */
+            result = (chunk->offset == 0) ? partial : operation::combine(result, partial);
+
+            et_compute.stop();
+
+            compute_seconds += static_cast<double>(et_compute.count_nanoseconds()) / 1e9;
+
+            reader.release();
         }
-        case LOG:
+
+        spdlog::info("Stream result: {}", operation::finish(result));
+    }
+    else
+    {
+        stream_writer writer(path_c, stream_chunk_size);
+
+        auto kernel = operation::kernel(simd_kernels::instance().get(), false, accuracy);
+
+        while(stream_chunk const *chunk = reader.acquire())
         {
-#pragma omp parallel for
-            for(std::size_t ic = 0; ic < iteration_count; ic++)
-            {
-                for(std::size_t i = 0; i < size_c; i++)
+            float *c = writer.acquire();
+
+            execution_time et_compute;
+            et_compute.start();
+
+            parallel_for(
+                0,
+                chunk->count,
+                parallel_for_grain,
+                [&](std::size_t begin, std::size_t end)
                 {
-                    start_iterator_c[i] = std::log(start_iterator_a[i]);
-                }
-            }
-            break;
-        }
-        default:
-        {
-            throw std::invalid_argument("Operation name type not found.");
-            break;
+                    if constexpr(binary)
+                    {
+                        kernel(&chunk->data[0][begin], &chunk->data[1][begin], &c[begin], end - begin);
+                    }
+                    else
+                    {
+                        kernel(&chunk->data[0][begin], &c[begin], end - begin);
+                    }
+                });
+
+            et_compute.stop();
+
+            compute_seconds += static_cast<double>(et_compute.count_nanoseconds()) / 1e9;
+
+            writer.commit(chunk->count);
+            reader.release();
         }
+
+        writer.finish();
+
+        write_wait_seconds = writer.get_wait_seconds();
     }
 
     et.stop();
 
-    spdlog::info("Time to parallel compute on cpu: {} (nanoseconds)", et.count_nanoseconds());
-    spdlog::info("Time to parallel compute on cpu: {} (milliseconds)", et.count_milliseconds());
+    report_stream(et, compute_seconds, reader.get_wait_seconds(), write_wait_seconds, reader.get_size(), get_operation_streams<operation>() * sizeof(float));
 }
 
 #endif // COMPUTE_COMPUTE_CPU_H
\ No newline at end of file
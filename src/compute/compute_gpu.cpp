@@ -26,6 +26,8 @@
  */
 #include "compute/compute_gpu.h"
 
+#include <algorithm>
+
 compute_gpu::compute_gpu(std::size_t const &vector_size, std::size_t const &iteration_count)
 {
     this->vector_size     = vector_size;
@@ -76,6 +78,8 @@ compute_gpu::compute_gpu(std::size_t const &vector_size, std::size_t const &iter
             spdlog::error("Error OpenCL building: {}", program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(default_device));
             return;
         }
+
+        pool = opencl_pool(context, default_device, program);
     }
     catch(cl::Error &e)
     {
@@ -127,11 +131,11 @@ void compute_gpu::print_info()
 
 void compute_gpu::compute_vec_16(std::string opencl_kernel_name)
 {
-    std::vector<cl_float16> vec_a_float_16(vector_size / 16, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float16> vec_b_float_16(vector_size / 16, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float16> vec_c_float_16(vector_size / 16, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float16> vec_a_float_16(vector_size / 16);
+    huge_page_vector<cl_float16> vec_b_float_16(vector_size / 16);
+    huge_page_vector<cl_float16> vec_c_float_16(vector_size / 16);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_16, vec_b_float_16);
 
     _compute(opencl_kernel_name, vec_a_float_16.begin(), vec_a_float_16.end(), vec_b_float_16.begin(), vec_b_float_16.end(), vec_c_float_16.begin(), vec_c_float_16.end());
@@ -139,11 +143,11 @@ void compute_gpu::compute_vec_16(std::string opencl_kernel_name)
 
 void compute_gpu::compute_vec_8(std::string opencl_kernel_name)
 {
-    std::vector<cl_float8> vec_a_float_8(vector_size / 8, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float8> vec_b_float_8(vector_size / 8, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float8> vec_c_float_8(vector_size / 8, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float8> vec_a_float_8(vector_size / 8);
+    huge_page_vector<cl_float8> vec_b_float_8(vector_size / 8);
+    huge_page_vector<cl_float8> vec_c_float_8(vector_size / 8);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_8, vec_b_float_8);
 
     _compute(opencl_kernel_name, vec_a_float_8.begin(), vec_a_float_8.end(), vec_b_float_8.begin(), vec_b_float_8.end(), vec_c_float_8.begin(), vec_c_float_8.end());
@@ -151,11 +155,11 @@ void compute_gpu::compute_vec_8(std::string opencl_kernel_name)
 
 void compute_gpu::compute_vec_4(std::string opencl_kernel_name)
 {
-    std::vector<cl_float4> vec_a_float_4(vector_size / 4, {0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float4> vec_b_float_4(vector_size / 4, {0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float4> vec_c_float_4(vector_size / 4, {0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float4> vec_a_float_4(vector_size / 4);
+    huge_page_vector<cl_float4> vec_b_float_4(vector_size / 4);
+    huge_page_vector<cl_float4> vec_c_float_4(vector_size / 4);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_4, vec_b_float_4);
 
     _compute(opencl_kernel_name, vec_a_float_4.begin(), vec_a_float_4.end(), vec_b_float_4.begin(), vec_b_float_4.end(), vec_c_float_4.begin(), vec_c_float_4.end());
@@ -163,11 +167,11 @@ void compute_gpu::compute_vec_4(std::string opencl_kernel_name)
 
 void compute_gpu::compute_vec_2(std::string opencl_kernel_name)
 {
-    std::vector<cl_float2> vec_a_float_2(vector_size / 2, {0.0, 0.0});
-    std::vector<cl_float2> vec_b_float_2(vector_size / 2, {0.0, 0.0});
-    std::vector<cl_float2> vec_c_float_2(vector_size / 2, {0.0, 0.0});
+    huge_page_vector<cl_float2> vec_a_float_2(vector_size / 2);
+    huge_page_vector<cl_float2> vec_b_float_2(vector_size / 2);
+    huge_page_vector<cl_float2> vec_c_float_2(vector_size / 2);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_2, vec_b_float_2);
 
     _compute(opencl_kernel_name, vec_a_float_2.begin(), vec_a_float_2.end(), vec_b_float_2.begin(), vec_b_float_2.end(), vec_c_float_2.begin(), vec_c_float_2.end());
@@ -175,10 +179,10 @@ void compute_gpu::compute_vec_2(std::string opencl_kernel_name)
 
 void compute_gpu::compute_one_vec_16(std::string opencl_kernel_name)
 {
-    std::vector<cl_float16> vec_a_float_16(vector_size / 16, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float16> vec_c_float_16(vector_size / 16, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float16> vec_a_float_16(vector_size / 16);
+    huge_page_vector<cl_float16> vec_c_float_16(vector_size / 16);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_16);
 
     _compute(opencl_kernel_name, vec_a_float_16.begin(), vec_a_float_16.end(), vec_c_float_16.begin(), vec_c_float_16.end());
@@ -186,10 +190,10 @@ void compute_gpu::compute_one_vec_16(std::string opencl_kernel_name)
 
 void compute_gpu::compute_one_vec_8(std::string opencl_kernel_name)
 {
-    std::vector<cl_float8> vec_a_float_8(vector_size / 8, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float8> vec_c_float_8(vector_size / 8, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float8> vec_a_float_8(vector_size / 8);
+    huge_page_vector<cl_float8> vec_c_float_8(vector_size / 8);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_8);
 
     _compute(opencl_kernel_name, vec_a_float_8.begin(), vec_a_float_8.end(), vec_c_float_8.begin(), vec_c_float_8.end());
@@ -197,10 +201,10 @@ void compute_gpu::compute_one_vec_8(std::string opencl_kernel_name)
 
 void compute_gpu::compute_one_vec_4(std::string opencl_kernel_name)
 {
-    std::vector<cl_float4> vec_a_float_4(vector_size / 4, {0.0, 0.0, 0.0, 0.0});
-    std::vector<cl_float4> vec_c_float_4(vector_size / 4, {0.0, 0.0, 0.0, 0.0});
+    huge_page_vector<cl_float4> vec_a_float_4(vector_size / 4);
+    huge_page_vector<cl_float4> vec_c_float_4(vector_size / 4);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_4);
 
     _compute(opencl_kernel_name, vec_a_float_4.begin(), vec_a_float_4.end(), vec_c_float_4.begin(), vec_c_float_4.end());
@@ -208,17 +212,231 @@ void compute_gpu::compute_one_vec_4(std::string opencl_kernel_name)
 
 void compute_gpu::compute_one_vec_2(std::string opencl_kernel_name)
 {
-    std::vector<cl_float2> vec_a_float_2(vector_size / 2, {0.0, 0.0});
-    std::vector<cl_float2> vec_c_float_2(vector_size / 2, {0.0, 0.0});
+    huge_page_vector<cl_float2> vec_a_float_2(vector_size / 2);
+    huge_page_vector<cl_float2> vec_c_float_2(vector_size / 2);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float_2);
 
     _compute(opencl_kernel_name, vec_a_float_2.begin(), vec_a_float_2.end(), vec_c_float_2.begin(), vec_c_float_2.end());
 }
 
+void compute_gpu::measure_roofline()
+{
+    try
+    {
+        cl::CommandQueue &queue = pool.get_queue();
+
+        /* Best of the runs, the first one only warms up */
+        std::size_t const runs = 6;
+
+        /* Every element is read and written once */
+        std::size_t size = std::min<std::size_t>(256 * 1024 * 1024, default_device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>()) / sizeof(cl_float4);
+
+        cl::Buffer buffer_a(context, CL_MEM_READ_ONLY, size * sizeof(cl_float4));
+        cl::Buffer buffer_c(context, CL_MEM_WRITE_ONLY, size * sizeof(cl_float4));
+
+        queue.enqueueFillBuffer(buffer_a, 1.0f, 0, size * sizeof(cl_float4));
+        queue.finish();
+
+        cl::KernelFunctor<cl::Buffer, cl::Buffer> kernel_funktor_copy(program, "roofline_copy");
+
+        double peak_bandwidth = 0;
+
+        for(std::size_t r = 0; r < runs; r++)
+        {
+            execution_time et;
+            et.start();
+
+            kernel_funktor_copy(cl::EnqueueArgs(queue, cl::NDRange(size)), buffer_a, buffer_c).wait();
+
+            et.stop();
+
+            double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+            if((r > 0) && (seconds > 0))
+            {
+                peak_bandwidth = std::max(peak_bandwidth, static_cast<double>(2 * sizeof(cl_float4) * size) / seconds);
+            }
+        }
+
+        /* 8 chains of multiply-add per work item (see roofline_flops.cl) */
+        std::size_t const work_items = 1 << 20;
+        cl_int const iterations      = 512;
+        double flops                 = static_cast<double>(work_items) * iterations * 8 * 2;
+
+        cl::Buffer buffer_flops(context, CL_MEM_WRITE_ONLY, work_items * sizeof(cl_float));
+
+        cl::KernelFunctor<cl::Buffer, cl_float, cl_float, cl_int> kernel_funktor_flops(program, "roofline_flops");
+
+        double peak_flops = 0;
+
+        for(std::size_t r = 0; r < runs; r++)
+        {
+            execution_time et;
+            et.start();
+
+            kernel_funktor_flops(cl::EnqueueArgs(queue, cl::NDRange(work_items)), buffer_flops, 0.999999f, 1e-6f, iterations).wait();
+
+            et.stop();
+
+            double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+            if((r > 0) && (seconds > 0))
+            {
+                peak_flops = std::max(peak_flops, flops / seconds);
+            }
+        }
+
+        gpu_roofline = roofline("gpu", peak_bandwidth, peak_flops);
+        gpu_roofline.print_peaks();
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+}
+
+double compute_gpu::get_flops_per_element(std::string const &opencl_kernel_name)
+{
+    /* (a + b) * (a + b), the sum is computed once */
+    if(opencl_kernel_name.rfind("exponentiation", 0) == 0)
+    {
+        return 2;
+    }
+
+    if(opencl_kernel_name.rfind("log", 0) == 0)
+    {
+        return roofline::log_flops;
+    }
+
+    /* addition, divide, multiple, remove */
+    return 1;
+}
+
+void compute_gpu::report(std::string const &opencl_kernel_name, execution_time const &et, std::size_t const &size, std::size_t const &buffers)
+{
+    double seconds  = static_cast<double>(et.count_nanoseconds()) / 1e9;
+    double elements = static_cast<double>(size / sizeof(cl_float)) * static_cast<double>(iteration_count);
+    double bytes    = static_cast<double>(size) * static_cast<double>(buffers) * static_cast<double>(iteration_count);
+
+    gpu_roofline.report(bytes, elements * get_flops_per_element(opencl_kernel_name), seconds);
+}
+
+execution_time compute_gpu::_launch(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &opencl_kernel_name, std::size_t const &global)
+{
+    /* A sweep (the first run of a kernel not in the tuning cache) is not timed */
+    cl::NDRange local = tuner.get_local(queue, kernel, opencl_kernel_name, global);
+
+    std::vector<cl::Event> events(iteration_count);
+
+    execution_time et;
+    et.start();
+
+    /* The queue is in order, the launches don't wait for the host between them */
+    for(std::size_t n = 0; n < iteration_count; n++)
+    {
+        queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(global), local, nullptr, &events[n]);
+    }
+
+    queue.finish();
+
+    et.stop();
+
+    if(events.empty())
+    {
+        return et;
+    }
+
+    double device_nanoseconds = 0;
+    double min_nanoseconds    = std::numeric_limits<double>::max();
+    double max_nanoseconds    = 0;
+
+    for(cl::Event const &event : events)
+    {
+        double nanoseconds = static_cast<double>(event.getProfilingInfo<CL_PROFILING_COMMAND_END>() - event.getProfilingInfo<CL_PROFILING_COMMAND_START>());
+
+        device_nanoseconds += nanoseconds;
+        min_nanoseconds     = std::min(min_nanoseconds, nanoseconds);
+        max_nanoseconds     = std::max(max_nanoseconds, nanoseconds);
+    }
+
+    /* From the start of the first launch to the end of the last one */
+    double span_nanoseconds = static_cast<double>(events.back().getProfilingInfo<CL_PROFILING_COMMAND_END>() - events.front().getProfilingInfo<CL_PROFILING_COMMAND_START>());
+    double host_nanoseconds = static_cast<double>(et.count_nanoseconds());
+
+    spdlog::info(
+        "Time per launch on gpu (device): {:.3f} average, {:.3f} min, {:.3f} max (microseconds)",
+        device_nanoseconds / static_cast<double>(events.size()) / 1e3,
+        min_nanoseconds / 1e3,
+        max_nanoseconds / 1e3);
+    spdlog::info("Time of the launches on gpu: {:.3f} (milliseconds device), {:.3f} (milliseconds host wall clock)", device_nanoseconds / 1e6, host_nanoseconds / 1e6);
+
+    if(host_nanoseconds > 0)
+    {
+        spdlog::info("Device idle between launches: {:.1f}% of the host wall clock", std::max(0.0, span_nanoseconds - device_nanoseconds) / host_nanoseconds * 100);
+    }
+
+    return et;
+}
+
+void compute_gpu::report_setup()
+{
+    double seconds = pool.take_setup_seconds();
+
+    spdlog::info("Time to set up on gpu: {:.3f} (milliseconds{})", seconds * 1e3, (seconds > 0) ? "" : ", everything reused");
+}
+
+void compute_gpu::report_pool() const
+{
+    pool.report();
+}
+
+void compute_gpu::set_transfer_mode(transfer_mode const &transfer)
+{
+    this->transfer = transfer;
+}
+
+char const *compute_gpu::get_transfer_mode_name(transfer_mode const &mode)
+{
+    switch(mode)
+    {
+        case TRANSFER_MODE_COPY:
+            return "copy";
+        case TRANSFER_MODE_HOST_POINTER:
+            return "host pointer";
+        case TRANSFER_MODE_HOST_ALLOCATED:
+            return "host allocated";
+        case TRANSFER_MODE_PIPELINE:
+            return "pipeline";
+        default:
+            return "all";
+    }
+}
+
+void compute_gpu::set_pipeline_chunks(std::size_t const &pipeline_chunks)
+{
+    this->pipeline_chunks = std::max<std::size_t>(pipeline_chunks, 1);
+}
+
+void compute_gpu::set_tuning(tune_mode const &mode, std::string const &cache_path)
+{
+    try
+    {
+        tuner = work_group_tuner(default_device, kernels, cache_path, mode);
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+}
+
 void compute_gpu::run_all()
 {
+    measure_roofline();
+
     // btw it works, but disabled 'cause it may cause troubles
     if(false)
         compute_lattice_2d("addition_lattice_2d");
@@ -249,18 +467,252 @@ void compute_gpu::run_all()
     compute_vec_2("remove_vector_2");
 
     compute_one_vec_16("log_vector_16");
-    compute_one_vec_16("log_vector_8");
-    compute_one_vec_16("log_vector_4");
-    compute_one_vec_16("log_vector_2");
+    compute_one_vec_8("log_vector_8");
+    compute_one_vec_4("log_vector_4");
+    compute_one_vec_2("log_vector_2");
+
+    report_pool();
+}
+
+void compute_gpu::set_log_accuracy(log_accuracy const &accuracy)
+{
+    this->accuracy = accuracy;
+}
+
+void compute_gpu::set_operations(std::vector<std::string> const &operations)
+{
+    this->operations = operations;
+}
+
+std::size_t compute_gpu::get_split(double const &cpu_share, std::size_t const &size)
+{
+    std::size_t split = static_cast<std::size_t>(cpu_share * static_cast<double>(size));
+
+    return std::min((split / split_alignment) * split_alignment, size);
+}
+
+void compute_gpu::run_transfer_bench()
+{
+    try
+    {
+        /* The benchmark needs the device memory the buffers of earlier runs hold */
+        pool.release_buffers();
+        buffer_mode = TRANSFER_MODE_ALL;
+
+        cl::CommandQueue &queue = pool.get_queue();
+
+        /* The device holds three buffers of the largest size and the pinned staging buffer */
+        std::size_t const smallest = 4 * 1024;
+        std::size_t largest        = std::min<std::size_t>(default_device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>(), default_device.getInfo<CL_DEVICE_GLOBAL_MEM_SIZE>() / 4);
+
+        if(largest < smallest)
+        {
+            spdlog::error("Transfer benchmark: the device can't allocate {} KiB", smallest / 1024);
+            return;
+        }
+
+        spdlog::info("Transfer benchmark on {}: {} KiB to {} KiB", default_device.getInfo<CL_DEVICE_NAME>(), smallest / 1024, largest / 1024);
+
+        /* Pageable memory is ordinary memory of the process, the runtime stages it through its own pinned buffers */
+        std::vector<float> pageable(largest / sizeof(float), 1.0f);
+        std::vector<float> result(largest / sizeof(float));
+
+        /* Pinned memory is host memory of the runtime (CL_MEM_ALLOC_HOST_PTR), mapped once for the whole run */
+        cl::Buffer pinned_buffer(context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, largest);
+        float *pinned = static_cast<float *>(queue.enqueueMapBuffer(pinned_buffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, largest));
+
+        std::fill(pinned, pinned + largest / sizeof(float), 1.0f);
+
+        cl::Buffer buffer_a(context, CL_MEM_READ_WRITE, largest);
+        cl::Buffer buffer_b(context, CL_MEM_READ_WRITE, largest);
+        cl::Buffer buffer_c(context, CL_MEM_READ_WRITE, largest);
+
+        cl::Kernel &kernel = pool.get_kernel("addition_vector_4");
+        kernel.setArg(0, buffer_a);
+        kernel.setArg(1, buffer_b);
+        kernel.setArg(2, buffer_c);
+
+        auto cpu_kernel = operation_addition::kernel(simd_kernels::instance().get(), false, accuracy);
+
+        /* The smallest size from which the device stays faster than the cpu, with pageable and with pinned memory */
+        std::size_t crossover_pageable = 0;
+        std::size_t crossover_pinned   = 0;
+
+        for(std::size_t bytes = smallest; bytes <= largest; bytes *= 2)
+        {
+            /* Enough runs for about 64 MiB of traffic, at least 3 */
+            std::size_t runs     = std::clamp<std::size_t>((64 * 1024 * 1024) / bytes, 3, 100);
+            std::size_t elements = bytes / sizeof(float);
+
+            double write_pageable = best_seconds(queue, runs, [&]() { queue.enqueueWriteBuffer(buffer_a, CL_TRUE, 0, bytes, pageable.data()); });
+            double write_pinned   = best_seconds(queue, runs, [&]() { queue.enqueueWriteBuffer(buffer_a, CL_TRUE, 0, bytes, pinned); });
+            double read_pageable  = best_seconds(queue, runs, [&]() { queue.enqueueReadBuffer(buffer_a, CL_TRUE, 0, bytes, result.data()); });
+            double read_pinned    = best_seconds(queue, runs, [&]() { queue.enqueueReadBuffer(buffer_a, CL_TRUE, 0, bytes, pinned); });
+            double copy           = best_seconds(queue, runs, [&]() { queue.enqueueCopyBuffer(buffer_a, buffer_b, 0, 0, bytes); });
+
+            /* Mapping a device buffer moves it to the host (nothing on a device sharing host memory) */
+            double map = best_seconds(
+                queue,
+                runs,
+                [&]()
+                {
+                    void *mapped = queue.enqueueMapBuffer(buffer_a, CL_TRUE, CL_MAP_READ, 0, bytes);
+                    queue.enqueueUnmapMemObject(buffer_a, mapped);
+                });
+
+            double launch = best_seconds(queue, runs, [&]() { queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(elements / 4), cl::NullRange); });
+
+            /* c = a + b on the device, the inputs go to the device and the result comes back */
+            auto device_addition = [&](float *host_a, float *host_b, float *host_c)
+            {
+                queue.enqueueWriteBuffer(buffer_a, CL_FALSE, 0, bytes, host_a);
+                queue.enqueueWriteBuffer(buffer_b, CL_FALSE, 0, bytes, host_b);
+                queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(elements / 4), cl::NullRange);
+                queue.enqueueReadBuffer(buffer_c, CL_TRUE, 0, bytes, host_c);
+            };
+
+            double device_pageable = best_seconds(queue, runs, [&]() { device_addition(pageable.data(), pageable.data(), result.data()); });
+            double device_pinned   = best_seconds(queue, runs, [&]() { device_addition(pinned, pinned, pinned); });
+
+            double cpu = best_seconds(
+                queue,
+                runs,
+                [&]()
+                {
+                    parallel_for(
+                        0,
+                        elements,
+                        parallel_for_grain,
+                        [&](std::size_t begin, std::size_t end) { cpu_kernel(&pageable[begin], &pageable[begin], &result[begin], end - begin); });
+                });
+
+            auto bandwidth = [&](double const &seconds) { return (seconds > 0) ? static_cast<double>(bytes) / seconds / 1e9 : 0; };
+
+            spdlog::info(
+                "Transfer {} KiB: write {:.3f} / {:.3f}, read {:.3f} / {:.3f} (GB/s pageable / pinned), copy {:.3f}, map {:.3f} (GB/s)",
+                bytes / 1024,
+                bandwidth(write_pageable),
+                bandwidth(write_pinned),
+                bandwidth(read_pageable),
+                bandwidth(read_pinned),
+                bandwidth(copy),
+                bandwidth(map));
+            spdlog::info(
+                "Transfer {} KiB: kernel {:.1f}, addition on device {:.1f} / {:.1f} (pageable / pinned), on cpu {:.1f} (microseconds)",
+                bytes / 1024,
+                launch * 1e6,
+                device_pageable * 1e6,
+                device_pinned * 1e6,
+                cpu * 1e6);
+
+            /* The latency is the time of the smallest transfer */
+            if(bytes == smallest)
+            {
+                spdlog::info(
+                    "Transfer latency: write {:.1f} / {:.1f}, read {:.1f} / {:.1f} (pageable / pinned), copy {:.1f}, map {:.1f}, kernel {:.1f} (microseconds)",
+                    write_pageable * 1e6,
+                    write_pinned * 1e6,
+                    read_pageable * 1e6,
+                    read_pinned * 1e6,
+                    copy * 1e6,
+                    map * 1e6,
+                    launch * 1e6);
+            }
+
+            crossover_pageable = (device_pageable < cpu) ? ((crossover_pageable == 0) ? bytes : crossover_pageable) : 0;
+            crossover_pinned   = (device_pinned < cpu) ? ((crossover_pinned == 0) ? bytes : crossover_pinned) : 0;
+
+            /* Doubling past the largest size would overflow for huge allocations */
+            if(bytes > largest / 2)
+            {
+                break;
+            }
+        }
+
+        auto report_crossover = [](char const *memory, std::size_t const &crossover)
+        {
+            if(crossover == 0)
+            {
+                spdlog::info("Transfer crossover ({}): addition on the cpu is faster at every size", memory);
+            }
+            else
+            {
+                spdlog::info("Transfer crossover ({}): addition on the device (transfers included) is faster from {} KiB", memory, crossover / 1024);
+            }
+        };
+
+        report_crossover("pageable", crossover_pageable);
+        report_crossover("pinned", crossover_pinned);
+
+        queue.enqueueUnmapMemObject(pinned_buffer, pinned);
+        queue.finish();
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+}
+
+void compute_gpu::run_split()
+{
+    try
+    {
+        /* The device part is float4 work items */
+        std::size_t size = vector_size - (vector_size % 4);
+
+        spdlog::info("Split between cpu ({} threads) and OpenCL device: {}", get_parallel_thread_count(), default_device.getInfo<CL_DEVICE_NAME>());
+
+        /* A cpu runtime (POCL for example) stands in for an accelerator, both parts run on the same cores then */
+        if(default_device.getInfo<CL_DEVICE_TYPE>() & CL_DEVICE_TYPE_CPU)
+        {
+            spdlog::info("Split device is a cpu, it shares the cores with the cpu part");
+        }
+
+        huge_page_vector<float> vec_a(size);
+        huge_page_vector<float> vec_b(size);
+        huge_page_vector<float> vec_c(size);
+
+        fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+        first_touch(vec_c.begin(), vec_c.end());
+
+        /* The split buffers replace the buffers of earlier runs */
+        pool.release_buffers();
+        buffer_mode = TRANSFER_MODE_ALL;
+
+        for_each_operation(
+            [&](auto op)
+            {
+                typedef decltype(op) operation;
+
+                if(!is_operation_selected(operations, operation::key))
+                {
+                    return;
+                }
+
+                /* The reductions have no OpenCL kernels */
+                if constexpr(operation::kind != OPERATION_REDUCTION)
+                {
+                    _split<operation>(vec_a, vec_b, vec_c);
+                }
+            });
+
+        report_pool();
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
 }
 
 void compute_gpu::compute_lattice_2d(std::string opencl_kernel_name)
 {
-    std::vector<cl_float2> vec_a_float(vector_size, {0.0, 0.0});
-    std::vector<cl_float2> vec_b_float(vector_size, {0.0, 0.0});
-    std::vector<cl_float2> vec_c_float(vector_size, {0.0, 0.0});
+    huge_page_vector<cl_float2> vec_a_float(vector_size);
+    huge_page_vector<cl_float2> vec_b_float(vector_size);
+    huge_page_vector<cl_float2> vec_c_float(vector_size);
 
-    /* Fill vectors */
+    /* Fill vectors (the result is written by cl::copy) */
     fill(vec_a_float, vec_b_float);
 
     _compute_lattice_2d(opencl_kernel_name, vec_a_float.begin(), vec_a_float.end(), vec_b_float.begin(), vec_b_float.end(), vec_c_float.begin(), vec_c_float.end());
@@ -39,15 +39,28 @@
 #endif
 // clang-format on
 
+#include "compute/fill_vectors.h"
+#include "compute/opencl_pool.h"
+#include "compute/operations.h"
+#include "compute/roofline.h"
+#include "compute/simd/simd_kernels.h"
+#include "compute/split_balance.h"
+#include "compute/work_group_tuner.h"
 #include "core/execution_time.h"
+#include "core/huge_page_allocator.h"
+#include "core/parallel_for.h"
 #include "io/log/logger.h"
 #include "io/kernel_loader.h"
 
 #include <CL/opencl.hpp>
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <iterator>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 class compute_gpu
 {
@@ -68,6 +81,38 @@ public:
     void compute_one_vec_2(std::string opencl_kernel_name);
     void compute_lattice_2d(std::string opencl_kernel_name);
 
+    /*
+        Co-execution: every elementwise float operation runs on one vector split between
+        the native cpu kernels and the OpenCL device, the split follows their throughput
+    */
+    void run_split();
+
+    /* Natural logarithm of the cpu part in run_split */
+    void set_log_accuracy(log_accuracy const &accuracy);
+
+    /* Keys of the operations to run (see compute/operations.h), every operation if empty */
+    void set_operations(std::vector<std::string> const &operations);
+
+    /* Print what the OpenCL pool holds and the time spent creating it */
+    void report_pool() const;
+
+    /*
+        Host <-> device transfers from 4 KiB to the largest buffer (CL_DEVICE_MAX_MEM_ALLOC_SIZE, at most a quarter
+        of the global memory): write, read, device copy and map bandwidth and latency, pageable and pinned
+        (CL_MEM_ALLOC_HOST_PTR) host memory, and the size from which addition on the device (transfers included)
+        is faster than on the cpu
+    */
+    void run_transfer_bench();
+
+    /* How the local work-group size of the kernels is picked and the file of the tuning cache */
+    void set_tuning(tune_mode const &mode, std::string const &cache_path);
+
+    /* How the vectors get to the device and back, every way side by side with TRANSFER_MODE_ALL */
+    void set_transfer_mode(transfer_mode const &transfer);
+
+    /* Chunks of the vectors in TRANSFER_MODE_PIPELINE (more when a chunk doesn't fit the device) */
+    void set_pipeline_chunks(std::size_t const &pipeline_chunks);
+
 private:
     /* Kernel loader instance */
     kernel_loader &kernel_loader_instance = kernel_loader::instance();
@@ -82,20 +127,83 @@ private:
     cl::Program program;
     std::size_t vector_size     = 102400000;
     std::size_t iteration_count = 100;
+    roofline gpu_roofline;
+
+    /* Queue, kernels and buffers shared by every run */
+    opencl_pool pool;
+
+    /* Local work-group sizes of the kernels, the runtime picks them until set_tuning */
+    work_group_tuner tuner;
+
+    log_accuracy accuracy  = LOG_ACCURACY_ACCURATE;
+    transfer_mode transfer = TRANSFER_MODE_COPY;
+
+    /* Transfer mode the pooled buffers were created for (TRANSFER_MODE_ALL: other runs) */
+    transfer_mode buffer_mode = TRANSFER_MODE_ALL;
+    std::vector<std::string> operations;
+    std::size_t pipeline_chunks = 8;
+
+    /*
+        Queues of the pipeline (upload, kernels, download) and buffer sets in flight,
+        chunk n uploads while n - 1 computes and n - 2 downloads
+    */
+    static constexpr std::size_t pipeline_slots = 3;
+
+    /* The device part starts at a multiple of split_alignment elements (float4 work items) */
+    static constexpr std::size_t split_alignment = 4096;
+
+    /* Neither side gets less than this share of the vector, so both keep being measured */
+    static constexpr double split_min_share = 1.0 / 64;
+
+    /* First element of the device part when cpu computes cpu_share of size elements */
+    std::size_t get_split(double const &cpu_share, std::size_t const &size);
+
+    /*
+        c = operation(a, b) or c = operation(a) iteration_count times, [0, split) on cpu
+        (SIMD kernels, parallel_for) while the device computes [split, size), the device
+        part of the inputs is written and its part of the result read back every iteration
+    */
+    template<typename operation>
+    void _split(huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> &vec_c);
+
+    /* Measure peak bandwidth (roofline_copy) and peak FLOP rate (roofline_flops) of the device */
+    void measure_roofline();
+
+    /* Floating point operations per element of the kernel, kernels are named <operation>_vector_<width> */
+    double get_flops_per_element(std::string const &opencl_kernel_name);
+
+    /*
+        Enqueue iteration_count launches of the kernel over global work items with the tuned local size
+        back to back and synchronize once, print the device time of the launches (profiling events)
+        and return the host wall clock
+    */
+    execution_time _launch(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &opencl_kernel_name, std::size_t const &global);
+
+    static char const *get_transfer_mode_name(transfer_mode const &mode);
+
+    /* Shortest of the runs of body, in seconds, the queue is finished after every run */
+    template<typename body_type>
+    double best_seconds(cl::CommandQueue &queue, std::size_t const &runs, body_type body);
+
+    /* Print the time the pool spent creating objects for the current run (nothing when everything is reused) */
+    void report_setup();
+
+    /* Print the roofline of a run, every element of the inputs and of the output is moved once per iteration */
+    void report(std::string const &opencl_kernel_name, execution_time const &et, std::size_t const &size, std::size_t const &buffers);
 
     /*
 		Function for fill vector with the test data
-		It allows only std::vector of OpenCL Vector Data Types
+		It allows only huge_page_vector of OpenCL Vector Data Types
 	*/
     template<typename cl_type>
-    void fill(std::vector<cl_type> &vec_a);
+    void fill(huge_page_vector<cl_type> &vec_a);
 
     /*
 		Function for fill vectors with the test data
-		It allows only std::vector of OpenCL Vector Data Types
+		It allows only huge_page_vector of OpenCL Vector Data Types
 	*/
     template<typename cl_type>
-    void fill(std::vector<cl_type> &vec_a, std::vector<cl_type> &vec_b);
+    void fill(huge_page_vector<cl_type> &vec_a, huge_page_vector<cl_type> &vec_b);
 
     /*
 		Function for compact long vector of type into vector of OpenCL vector
@@ -133,6 +241,33 @@ private:
     template<typename iterator_type>
     void _compute(std::string opencl_application_name, iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_c, iterator_type end_iterator_c);
 
+    /*
+        Run the kernel over the inputs (a or a and b, count elements each) into c in the transfer mode, every mode
+        with TRANSFER_MODE_ALL, vectors larger than CL_DEVICE_MAX_MEM_ALLOC_SIZE always run as TRANSFER_MODE_PIPELINE
+    */
+    template<typename iterator_type>
+    void _run(std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count);
+
+    /*
+        One run in the transfer mode:
+            TRANSFER_MODE_COPY - inputs are copied into device buffers, the result is copied back
+            TRANSFER_MODE_HOST_POINTER - the vectors are the buffers (CL_MEM_USE_HOST_PTR), the result is mapped
+            TRANSFER_MODE_HOST_ALLOCATED - buffers in host memory of the runtime (CL_MEM_ALLOC_HOST_PTR)
+            are mapped and filled, the result is mapped and copied
+        Returns the seconds of the transfers and the kernels
+    */
+    template<typename iterator_type>
+    double _transfer(
+        transfer_mode const &mode, std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count);
+
+    /*
+        TRANSFER_MODE_PIPELINE: the vectors are split into chunks that fit the device, chunk n is written on one queue,
+        computed (iteration_count launches) on another and read back on the third, events order the queues
+        Returns the seconds of the whole pipeline
+    */
+    template<typename iterator_type>
+    double _pipeline(std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count);
+
     template<typename iterator_type>
     void _compute_lattice_2d(
         std::string opencl_application_name,
@@ -147,22 +282,28 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename cl_type>
-void compute_gpu::fill(std::vector<cl_type> &vec_a)
+void compute_gpu::fill(huge_page_vector<cl_type> &vec_a)
 {
     std::size_t cl_type_arr_size = (sizeof(vec_a[0].s) / sizeof(vec_a[0].s[0]));
 
-#pragma omp parallel for
-    for(std::size_t i = 0; i < vec_a.size(); i++)
-    {
-        for(std::size_t n = 0; n < cl_type_arr_size; n++)
+    parallel_for(
+        0,
+        vec_a.size(),
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
         {
-            vec_a[i].s[n] = (float)(i + n) / 2;
-        }
-    }
+            for(std::size_t i = begin; i < end; i++)
+            {
+                for(std::size_t n = 0; n < cl_type_arr_size; n++)
+                {
+                    vec_a[i].s[n] = (float)(i + n) / 2;
+                }
+            }
+        });
 }
 
 template<typename cl_type>
-void compute_gpu::fill(std::vector<cl_type> &vec_a, std::vector<cl_type> &vec_b)
+void compute_gpu::fill(huge_page_vector<cl_type> &vec_a, huge_page_vector<cl_type> &vec_b)
 {
     if(vec_a.size() != vec_b.size())
     {
@@ -171,23 +312,22 @@ void compute_gpu::fill(std::vector<cl_type> &vec_a, std::vector<cl_type> &vec_b)
 
     std::size_t cl_type_arr_size = (sizeof(vec_a[0].s) / sizeof(vec_a[0].s[0]));
 
-#pragma omp parallel for
-    for(std::size_t i = 0; i < vec_a.size(); i++)
-    {
-        for(std::size_t n = 0; n < cl_type_arr_size; n++)
-        {
-            vec_a[i].s[n] = (float)(i + n) / 2;
-        }
-    }
-
-#pragma omp parallel for
-    for(std::size_t i = 0; i < vec_b.size(); i++)
-    {
-        for(std::size_t n = 0; n < cl_type_arr_size; n++)
+    /* A single pass, the vectors are uninitialized and every page is touched once */
+    parallel_for(
+        0,
+        vec_a.size(),
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
         {
-            vec_b[i].s[n] = (float)(i + n) * 3;
-        }
-    }
+            for(std::size_t i = begin; i < end; i++)
+            {
+                for(std::size_t n = 0; n < cl_type_arr_size; n++)
+                {
+                    vec_a[i].s[n] = (float)(i + n) / 2;
+                    vec_b[i].s[n] = (float)(i + n) * 3;
+                }
+            }
+        });
 }
 
 template<typename vec_type, typename cl_type>
@@ -200,14 +340,41 @@ void compute_gpu::compact(std::vector<vec_type> const &vec, std::vector<cl_type>
         throw std::length_error("Length error. Can't compact vec to v.");
     }
 
-#pragma omp parallel for
-    for(std::size_t i = 0; i < v.size(); i++)
-    {
-        for(std::size_t n = 0; n < cl_type_arr_size; n++)
+    parallel_for(
+        0,
+        v.size(),
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
         {
-            v[i].s[n] = vec[(i * cl_type_arr_size) + n];
-        }
+            for(std::size_t i = begin; i < end; i++)
+            {
+                for(std::size_t n = 0; n < cl_type_arr_size; n++)
+                {
+                    v[i].s[n] = vec[(i * cl_type_arr_size) + n];
+                }
+            }
+        });
+}
+
+template<typename body_type>
+double compute_gpu::best_seconds(cl::CommandQueue &queue, std::size_t const &runs, body_type body)
+{
+    double best = std::numeric_limits<double>::max();
+
+    for(std::size_t r = 0; r < runs; r++)
+    {
+        execution_time et;
+        et.start();
+
+        body();
+        queue.finish();
+
+        et.stop();
+
+        best = std::min(best, static_cast<double>(et.count_nanoseconds()) / 1e9);
     }
+
+    return best;
 }
 
 template<typename iterator_type>
@@ -233,101 +400,339 @@ void compute_gpu::_compute(
 
     spdlog::info("OpenCL application: {}", opencl_application_name);
 
-    /*
-		true means that this is a read-only buffer
-		(false) means: read/write (default)
-	*/
-    cl::Buffer vec_buffer_a(context, start_iterator_a, end_iterator_a, true);
-    cl::Buffer vec_buffer_b(context, start_iterator_b, end_iterator_b, true);
-    cl::Buffer vec_buffer_c(context, CL_MEM_WRITE_ONLY, size_c);
+    _run(opencl_application_name, {start_iterator_a, start_iterator_b}, start_iterator_c, end_iterator_a - start_iterator_a);
+}
 
-    cl::Kernel kernel_simple_add(program, opencl_application_name.c_str());
+template<typename iterator_type>
+void compute_gpu::_compute(
+    std::string opencl_application_name, iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_c, iterator_type end_iterator_c)
+{
+    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
 
-    std::size_t local_work_group_size = kernel_simple_add.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(cl::Device::getDefault());
+    std::size_t size_a = sizeof(data_type) * (end_iterator_a - start_iterator_a);
+    std::size_t size_c = sizeof(data_type) * (end_iterator_c - start_iterator_c);
 
-    cl::CommandQueue queue(context, default_device);
+    if(size_a != size_c)
+    {
+        throw std::logic_error("Iterators are not equal.");
+    }
 
-    /*
-		We need to specify global (and local) dimensions
-		cl::NDRange global(1024);
-		cl::NDRange local(64)
+    spdlog::info("OpenCL application: {}", opencl_application_name);
 
-		If you don’t specify a local dimension, it is assumed as cl::NullRange, and
-		the runtime picks a size for you
-	*/
-    cl::NDRange global(end_iterator_a - start_iterator_a);
-    cl::KernelFunctor<cl::Buffer, cl::Buffer, cl::Buffer> kernel_funktor_simple_add(program, opencl_application_name);
+    _run(opencl_application_name, {start_iterator_a}, start_iterator_c, end_iterator_a - start_iterator_a);
+}
 
-    execution_time et;
-    et.start();
+template<typename iterator_type>
+void compute_gpu::_run(std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count)
+{
+    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
 
-    for(std::size_t n = 0; n < iteration_count; n++)
+    std::vector<transfer_mode> modes = {transfer};
+
+    if(transfer == TRANSFER_MODE_ALL)
     {
-        kernel_funktor_simple_add(cl::EnqueueArgs(queue, global), vec_buffer_a, vec_buffer_b, vec_buffer_c).wait();
+        modes = {TRANSFER_MODE_COPY, TRANSFER_MODE_HOST_POINTER, TRANSFER_MODE_HOST_ALLOCATED, TRANSFER_MODE_PIPELINE};
     }
 
-    et.stop();
+    /* A buffer of the whole vector can't be created */
+    std::size_t max_alloc = default_device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>();
 
-    cl::copy(queue, vec_buffer_c, start_iterator_c, end_iterator_c);
+    if((sizeof(data_type) * count > max_alloc) && (transfer != TRANSFER_MODE_PIPELINE))
+    {
+        spdlog::info("Vectors of {} MiB exceed CL_DEVICE_MAX_MEM_ALLOC_SIZE ({} MiB), running as pipeline", sizeof(data_type) * count / (1024 * 1024), max_alloc / (1024 * 1024));
 
-    spdlog::info("Time to parallel compute on gpu: {} (nanoseconds)", et.count_nanoseconds());
-    spdlog::info("Time to parallel compute on gpu: {} (milliseconds)", et.count_milliseconds());
+        modes = {TRANSFER_MODE_PIPELINE};
+    }
+
+    std::vector<double> seconds;
+
+    for(transfer_mode const &mode : modes)
+    {
+        /* The buffers of one mode are freed before the next mode creates its own, so the device holds one set at a time */
+        if(mode != buffer_mode)
+        {
+            pool.release_buffers();
+            buffer_mode = mode;
+        }
+
+        if(mode == TRANSFER_MODE_PIPELINE)
+        {
+            seconds.push_back(_pipeline(opencl_application_name, inputs, start_iterator_c, count));
+        }
+        else
+        {
+            seconds.push_back(_transfer(mode, opencl_application_name, inputs, start_iterator_c, count));
+        }
+    }
+
+    if(modes.size() > 1)
+    {
+        spdlog::info(
+            "Time of {} by transfer mode: {:.3f} copy, {:.3f} host pointer, {:.3f} host allocated, {:.3f} pipeline (milliseconds, transfers and kernels)",
+            opencl_application_name,
+            seconds[0] * 1e3,
+            seconds[1] * 1e3,
+            seconds[2] * 1e3,
+            seconds[3] * 1e3);
+    }
 }
 
 template<typename iterator_type>
-void compute_gpu::_compute(
-    std::string opencl_application_name, iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_c, iterator_type end_iterator_c)
+double compute_gpu::_transfer(
+    transfer_mode const &mode, std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count)
 {
     typedef typename std::iterator_traits<iterator_type>::value_type data_type;
 
-    std::size_t size_a = sizeof(data_type) * (end_iterator_a - start_iterator_a);
-    std::size_t size_c = sizeof(data_type) * (end_iterator_c - start_iterator_c);
+    std::size_t size = sizeof(data_type) * count;
 
-    if(size_a != size_c)
+    spdlog::info("Transfer mode on gpu: {}", get_transfer_mode_name(mode));
+
+    /* The pool creates the kernel, the queue and the buffers of copy and host allocated once, later runs reuse them */
+    cl::Kernel &kernel      = pool.get_kernel(opencl_application_name);
+    cl::CommandQueue &queue = pool.get_queue();
+
+    std::vector<cl::Buffer> buffers;
+    cl::Buffer buffer_c;
+
+    if(mode == TRANSFER_MODE_COPY)
     {
-        throw std::logic_error("Iterators are not equal.");
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            buffers.push_back(pool.get_buffer(size, CL_MEM_READ_ONLY, i));
+        }
+
+        buffer_c = pool.get_buffer(size, CL_MEM_WRITE_ONLY, 0);
     }
+    else if(mode == TRANSFER_MODE_HOST_ALLOCATED)
+    {
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            buffers.push_back(pool.get_buffer(size, CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, i));
+        }
 
-    spdlog::info("OpenCL application: {}", opencl_application_name);
+        buffer_c = pool.get_buffer(size, CL_MEM_WRITE_ONLY | CL_MEM_ALLOC_HOST_PTR, 0);
+    }
 
-    /*
-			true means that this is a read-only buffer
-			(false) means: read/write (default)
-		*/
-    cl::Buffer vec_buffer_a(context, start_iterator_a, end_iterator_a, true);
-    cl::Buffer vec_buffer_c(context, CL_MEM_WRITE_ONLY, size_c);
+    report_setup();
 
-    cl::Kernel kernel_simple_add(program, opencl_application_name.c_str());
+    execution_time et_upload;
+    et_upload.start();
 
-    std::size_t local_work_group_size = kernel_simple_add.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(cl::Device::getDefault());
+    if(mode == TRANSFER_MODE_COPY)
+    {
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            cl::copy(queue, inputs[i], inputs[i] + count, buffers[i]);
+        }
+    }
+    else if(mode == TRANSFER_MODE_HOST_POINTER)
+    {
+        /*
+            The buffers are the vectors themselves, huge_page_vector aligns them to a huge page
+            (CL_DEVICE_MEM_BASE_ADDR_ALIGN is much less), a device sharing host memory uses them
+            in place, others copy them when the first kernel needs them, so that time is in the kernels
+        */
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            buffers.push_back(cl::Buffer(context, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, size, &*inputs[i]));
+        }
 
-    cl::CommandQueue queue(context, default_device);
+        buffer_c = cl::Buffer(context, CL_MEM_WRITE_ONLY | CL_MEM_USE_HOST_PTR, size, &*start_iterator_c);
+    }
+    else
+    {
+        /* The runtime allocates host memory it can map without a copy (pinned memory on discrete devices) */
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            data_type *mapped = static_cast<data_type *>(queue.enqueueMapBuffer(buffers[i], CL_TRUE, CL_MAP_WRITE_INVALIDATE_REGION, 0, size));
 
-    /*
-		We need to specify global (and local) dimensions
-		cl::NDRange global(1024);
-		cl::NDRange local(64)
+            std::copy(inputs[i], inputs[i] + count, mapped);
 
-		If you don’t specify a local dimension, it is assumed as cl::NullRange, and
-		the runtime picks a size for you
-	*/
-    cl::NDRange global(end_iterator_a - start_iterator_a);
-    cl::KernelFunctor<cl::Buffer, cl::Buffer> kernel_funktor_simple_add(program, opencl_application_name);
+            queue.enqueueUnmapMemObject(buffers[i], mapped);
+        }
+
+        queue.finish();
+    }
+
+    et_upload.stop();
+
+    for(std::size_t i = 0; i < inputs.size(); i++)
+    {
+        kernel.setArg(i, buffers[i]);
+    }
+
+    kernel.setArg(inputs.size(), buffer_c);
+
+    /* The local size comes from the tuner (cl::NullRange, the runtime choice, when tuning is off) */
+    execution_time et = _launch(queue, kernel, opencl_application_name, count);
+
+    execution_time et_download;
+    et_download.start();
+
+    if(mode == TRANSFER_MODE_COPY)
+    {
+        cl::copy(queue, buffer_c, start_iterator_c, start_iterator_c + count);
+    }
+    else
+    {
+        /* Mapping the result makes it visible to the host, in place for host pointer buffers */
+        data_type *mapped = static_cast<data_type *>(queue.enqueueMapBuffer(buffer_c, CL_TRUE, CL_MAP_READ, 0, size));
+
+        if(mode == TRANSFER_MODE_HOST_ALLOCATED)
+        {
+            std::copy(mapped, mapped + count, start_iterator_c);
+        }
+
+        queue.enqueueUnmapMemObject(buffer_c, mapped);
+        queue.finish();
+    }
+
+    et_download.stop();
+
+    spdlog::info("Time to parallel compute on gpu: {} (nanoseconds)", et.count_nanoseconds());
+    spdlog::info("Time to parallel compute on gpu: {} (milliseconds)", et.count_milliseconds());
+    spdlog::info("Time to transfer on gpu: {} (milliseconds upload), {} (milliseconds download)", et_upload.count_milliseconds(), et_download.count_milliseconds());
+
+    report(opencl_application_name, et, size, inputs.size() + 1);
+
+    return static_cast<double>(et_upload.count_nanoseconds() + et.count_nanoseconds() + et_download.count_nanoseconds()) / 1e9;
+}
+
+template<typename iterator_type>
+double compute_gpu::_pipeline(std::string const &opencl_application_name, std::vector<iterator_type> const &inputs, iterator_type start_iterator_c, std::size_t const &count)
+{
+    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
+
+    spdlog::info("Transfer mode on gpu: {}", get_transfer_mode_name(TRANSFER_MODE_PIPELINE));
+
+    /* Every slot holds the inputs and the result of a chunk, all of them have to fit the device */
+    std::size_t buffers   = pipeline_slots * (inputs.size() + 1);
+    std::size_t max_bytes = std::min<std::size_t>(default_device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>(), default_device.getInfo<CL_DEVICE_GLOBAL_MEM_SIZE>() / buffers);
+
+    std::size_t chunk      = std::min((count + pipeline_chunks - 1) / pipeline_chunks, std::max<std::size_t>(max_bytes / sizeof(data_type), 1));
+    std::size_t chunks     = (count + chunk - 1) / chunk;
+    std::size_t chunk_size = chunk * sizeof(data_type);
+
+    spdlog::info("Pipeline on gpu: {} chunks of {} elements ({} MiB), {} queues", chunks, chunk, chunk_size / (1024 * 1024), pipeline_slots);
+
+    cl::Kernel &kernel             = pool.get_kernel(opencl_application_name);
+    cl::CommandQueue &queue_write  = pool.get_queue(0);
+    cl::CommandQueue &queue_kernel = pool.get_queue(1);
+    cl::CommandQueue &queue_read   = pool.get_queue(2);
+
+    /* Inputs first, the result last (the pool tells them apart by the index) */
+    std::vector<std::vector<cl::Buffer>> slots(pipeline_slots);
+
+    for(std::size_t s = 0; s < pipeline_slots; s++)
+    {
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            slots[s].push_back(pool.get_buffer(chunk_size, CL_MEM_READ_ONLY, s * inputs.size() + i));
+        }
+
+        slots[s].push_back(pool.get_buffer(chunk_size, CL_MEM_WRITE_ONLY, s));
+    }
+
+    report_setup();
+
+    std::vector<cl::Event> write_events;
+    std::vector<cl::Event> kernel_events;
+    std::vector<cl::Event> read_events(chunks);
+
+    /* What the read of a chunk waits for, its last launch (its writes without launches) */
+    std::vector<std::vector<cl::Event>> computed(chunks);
 
     execution_time et;
     et.start();
 
-    for(std::size_t n = 0; n < iteration_count; n++)
+    for(std::size_t n = 0; n < chunks; n++)
     {
-        kernel_funktor_simple_add(cl::EnqueueArgs(queue, global), vec_buffer_a, vec_buffer_c).wait();
+        std::size_t begin             = n * chunk;
+        std::size_t elements          = std::min(chunk, count - begin);
+        std::size_t bytes             = elements * sizeof(data_type);
+        std::vector<cl::Buffer> &slot = slots[n % pipeline_slots];
+
+        /* The slot is free again when the previous chunk in it is computed and read back */
+        std::vector<cl::Event> slot_free;
+
+        if(n >= pipeline_slots)
+        {
+            slot_free = computed[n - pipeline_slots];
+            slot_free.push_back(read_events[n - pipeline_slots]);
+        }
+
+        std::vector<cl::Event> written(inputs.size());
+
+        for(std::size_t i = 0; i < inputs.size(); i++)
+        {
+            queue_write.enqueueWriteBuffer(slot[i], CL_FALSE, 0, bytes, &*(inputs[i] + begin), slot_free.empty() ? nullptr : &slot_free, &written[i]);
+        }
+
+        write_events.insert(write_events.end(), written.begin(), written.end());
+
+        for(std::size_t i = 0; i < slot.size(); i++)
+        {
+            kernel.setArg(i, slot[i]);
+        }
+
+        /* The arguments are captured at enqueue, the next chunk may set others */
+        cl::NDRange local           = tuner.find_local(opencl_application_name, elements);
+        std::vector<cl::Event> wait = written;
+
+        for(std::size_t r = 0; r < iteration_count; r++)
+        {
+            cl::Event event;
+            queue_kernel.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(elements), local, &wait, &event);
+
+            kernel_events.push_back(event);
+            wait = {event};
+        }
+
+        computed[n] = wait;
+
+        queue_read.enqueueReadBuffer(slot.back(), CL_FALSE, 0, bytes, &*(start_iterator_c + begin), &computed[n], &read_events[n]);
+
+        queue_write.flush();
+        queue_kernel.flush();
+        queue_read.flush();
     }
 
+    queue_write.finish();
+    queue_kernel.finish();
+    queue_read.finish();
+
     et.stop();
 
-    cl::copy(queue, vec_buffer_c, start_iterator_c, end_iterator_c);
+    auto device_seconds = [](std::vector<cl::Event> const &events)
+    {
+        double seconds = 0;
 
-    spdlog::info("Time to parallel compute on gpu: {} (nanoseconds)", et.count_nanoseconds());
-    spdlog::info("Time to parallel compute on gpu: {} (milliseconds)", et.count_milliseconds());
+        for(cl::Event const &event : events)
+        {
+            seconds += static_cast<double>(event.getProfilingInfo<CL_PROFILING_COMMAND_END>() - event.getProfilingInfo<CL_PROFILING_COMMAND_START>()) / 1e9;
+        }
+
+        return seconds;
+    };
+
+    double write_seconds  = device_seconds(write_events);
+    double kernel_seconds = device_seconds(kernel_events);
+    double read_seconds   = device_seconds(read_events);
+    double seconds        = static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    spdlog::info("Time to pipeline on gpu: {} (milliseconds wall clock)", et.count_milliseconds());
+    spdlog::info(
+        "Time on the pipeline queues: {:.3f} upload, {:.3f} kernels, {:.3f} download (milliseconds device)", write_seconds * 1e3, kernel_seconds * 1e3, read_seconds * 1e3);
+
+    /* 1 when nothing overlaps, up to 3 when the queues are busy all the time */
+    if(seconds > 0)
+    {
+        spdlog::info("Pipeline overlap on gpu: {:.2f} (device time of the queues / wall clock)", (write_seconds + kernel_seconds + read_seconds) / seconds);
+    }
+
+    report(opencl_application_name, et, sizeof(data_type) * count, inputs.size() + 1);
+
+    return seconds;
 }
 
 template<typename iterator_type>
@@ -353,46 +758,142 @@ void compute_gpu::_compute_lattice_2d(
 
     spdlog::info("OpenCL application: {}", opencl_application_name);
 
-    /*
-		true means that this is a read-only buffer
-		(false) means: read/write (default)
-	*/
-    cl::Buffer vec_buffer_a(context, start_iterator_a, end_iterator_a, true);
-    cl::Buffer vec_buffer_b(context, start_iterator_b, end_iterator_b, true);
-    cl::Buffer vec_buffer_c(context, CL_MEM_WRITE_ONLY, size_c);
+    /* The pool creates the kernel, the queue and the buffers once, later runs reuse them */
+    cl::Kernel &kernel      = pool.get_kernel(opencl_application_name);
+    cl::CommandQueue &queue = pool.get_queue();
+    cl::Buffer &buffer_a    = pool.get_buffer(size_a, CL_MEM_READ_ONLY, 0);
+    cl::Buffer &buffer_b    = pool.get_buffer(size_b, CL_MEM_READ_ONLY, 1);
+    cl::Buffer &buffer_c    = pool.get_buffer(size_c, CL_MEM_WRITE_ONLY, 0);
 
-    cl::Kernel kernel_simple_add(program, opencl_application_name.c_str());
+    report_setup();
 
-    std::size_t local_work_group_size = kernel_simple_add.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(cl::Device::getDefault());
+    cl::copy(queue, start_iterator_a, end_iterator_a, buffer_a);
+    cl::copy(queue, start_iterator_b, end_iterator_b, buffer_b);
 
-    cl::CommandQueue queue(context, default_device);
+    kernel.setArg(0, buffer_a);
+    kernel.setArg(1, buffer_b);
+    kernel.setArg(2, buffer_c);
 
-    /*
-		We need to specify global (and local) dimensions
-		cl::NDRange global(1024);
-		cl::NDRange local(64)
+    /* Every work item adds two elements */
+    execution_time et = _launch(queue, kernel, opencl_application_name, (end_iterator_a - start_iterator_a) / 2);
 
-		If you don’t specify a local dimension, it is assumed as cl::NullRange, and
-		the runtime picks a size for you
-	*/
-    //cl::NDRange global(end_iterator_a - start_iterator_a);
-    cl::NDRange global((end_iterator_a - start_iterator_a) / 2, 1);
-    cl::KernelFunctor<cl::Buffer, cl::Buffer, cl::Buffer> kernel_funktor_simple_add(program, opencl_application_name);
+    cl::copy(queue, buffer_c, start_iterator_c, end_iterator_c);
+
+    spdlog::info("Time to parallel compute on gpu: {} (nanoseconds)", et.count_nanoseconds());
+    spdlog::info("Time to parallel compute on gpu: {} (milliseconds)", et.count_milliseconds());
+}
+
+template<typename operation>
+void compute_gpu::_split(huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> &vec_c)
+{
+    constexpr bool binary                   = (operation::kind == OPERATION_BINARY);
+    constexpr std::size_t bytes_per_element = get_operation_streams<operation>() * sizeof(float);
+
+    std::size_t size  = vec_c.size();
+    std::size_t bytes = size * sizeof(float);
+
+    spdlog::info("Split application: {} (cpu: {}, device: {})", operation::name, simd_kernels::get_isa_name(simd_kernels::instance().get_isa()), operation::opencl_kernel);
+
+    auto kernel = operation::kernel(simd_kernels::instance().get(), false, accuracy);
+
+    /* Unary operations don't read b */
+    cl::Buffer &buffer_a      = pool.get_buffer(bytes, CL_MEM_READ_ONLY, 0);
+    cl::Buffer &buffer_b      = binary ? pool.get_buffer(bytes, CL_MEM_READ_ONLY, 1) : buffer_a;
+    cl::Buffer &buffer_c      = pool.get_buffer(bytes, CL_MEM_WRITE_ONLY, 0);
+    cl::Kernel &device_kernel = pool.get_kernel(operation::opencl_kernel);
+    cl::CommandQueue &queue   = pool.get_queue();
+
+    set_shard_arguments<operation>(device_kernel, buffer_a, buffer_b, buffer_c);
+
+    report_setup();
+
+    /* Both sides start with half of the vector */
+    double cpu_share       = 0.5;
+    double first_share     = cpu_share;
+    double cpu_seconds     = 0;
+    double device_seconds  = 0;
+    double cpu_elements    = 0;
+    double device_elements = 0;
 
     execution_time et;
     et.start();
 
     for(std::size_t n = 0; n < iteration_count; n++)
     {
-        kernel_funktor_simple_add(cl::EnqueueArgs(queue, global), vec_buffer_a, vec_buffer_b, vec_buffer_c).wait();
+        std::size_t split = get_split(cpu_share, size);
+
+        cl::Event write_event;
+        cl::Event read_event;
+
+        /* The device part is queued first (at its place in the buffers of the whole vector), so the device works while the cpu computes its part */
+        if(split < size)
+        {
+            cl::NDRange local = tuner.find_local(operation::opencl_kernel, (size - split) / 4);
+
+            enqueue_shard<operation>(queue, device_kernel, local, buffer_a, buffer_b, buffer_c, vec_a, vec_b, vec_c, split, size, 0, write_event, read_event);
+        }
+
+        execution_time et_cpu;
+        et_cpu.start();
+
+        parallel_for(
+            0,
+            split,
+            parallel_for_grain,
+            [&](std::size_t begin, std::size_t end)
+            {
+                if constexpr(binary)
+                {
+                    kernel(&vec_a[begin], &vec_b[begin], &vec_c[begin], end - begin);
+                }
+                else
+                {
+                    kernel(&vec_a[begin], &vec_c[begin], end - begin);
+                }
+            });
+
+        et_cpu.stop();
+
+        double cpu_time    = static_cast<double>(et_cpu.count_nanoseconds()) / 1e9;
+        double device_time = 0;
+
+        if(split < size)
+        {
+            device_time = get_shard_seconds(write_event, read_event);
+        }
+
+        double cpu_rate    = (cpu_time > 0) ? static_cast<double>(split) / cpu_time : 0;
+        double device_rate = (device_time > 0) ? static_cast<double>(size - split) / device_time : 0;
+
+        spdlog::debug("Split iteration {}: cpu share {:.3f}, cpu {:.3f} Gelements/s, device {:.3f} Gelements/s", n, cpu_share, cpu_rate / 1e9, device_rate / 1e9);
+
+        cpu_seconds     += cpu_time;
+        device_seconds  += device_time;
+        cpu_elements    += static_cast<double>(split);
+        device_elements += static_cast<double>(size - split);
+
+        cpu_share = balance_shares({cpu_share, 1 - cpu_share}, {cpu_rate, device_rate}, split_min_share)[0];
     }
 
     et.stop();
 
-    cl::copy(queue, vec_buffer_c, start_iterator_c, end_iterator_c);
+    double seconds = static_cast<double>(et.count_nanoseconds()) / 1e9;
+    double total   = static_cast<double>(size) * static_cast<double>(iteration_count);
 
-    spdlog::info("Time to parallel compute on gpu: {} (nanoseconds)", et.count_nanoseconds());
-    spdlog::info("Time to parallel compute on gpu: {} (milliseconds)", et.count_milliseconds());
+    spdlog::info("Time to split compute: {} (milliseconds)", et.count_milliseconds());
+    spdlog::info("Split cpu share: {:.1f}% at the start, {:.1f}% at the end", first_share * 100, cpu_share * 100);
+
+    if(seconds > 0)
+    {
+        spdlog::info(
+            "Split throughput: cpu {:.3f}, device {:.3f}, both {:.3f} (Gelements/s)",
+            (cpu_seconds > 0) ? cpu_elements / cpu_seconds / 1e9 : 0,
+            (device_seconds > 0) ? device_elements / device_seconds / 1e9 : 0,
+            total / seconds / 1e9);
+        spdlog::info("Split bandwidth: {:.3f} GB/s", total * bytes_per_element / seconds / 1e9);
+    }
+
+    verify_split<operation>("Split", vec_a, vec_b, vec_c);
 }
 
 #endif // COMPUTE_COMPUTE_GPU_H
\ No newline at end of file
@@ -0,0 +1,275 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Compute one vector on every OpenCL device of every platform
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/compute_multi_device.h"
+
+compute_multi_device::compute_multi_device(std::size_t const &vector_size, std::size_t const &iteration_count, std::size_t const &sub_devices)
+{
+    this->vector_size     = vector_size;
+    this->iteration_count = iteration_count;
+
+    kernels = kernel_loader::instance().get();
+
+    try
+    {
+        std::vector<cl::Platform> all_platforms;
+        cl::Platform::get(&all_platforms);
+
+        for(auto &platform : all_platforms)
+        {
+            std::vector<cl::Device> all_devices;
+
+            try
+            {
+                platform.getDevices(CL_DEVICE_TYPE_ALL, &all_devices);
+            }
+            catch(cl::Error &e)
+            {
+                /* A platform without devices reports CL_DEVICE_NOT_FOUND */
+                continue;
+            }
+
+            for(auto &device : all_devices)
+            {
+                std::string name = platform.getInfo<CL_PLATFORM_NAME>() + " / " + device.getInfo<CL_DEVICE_NAME>();
+
+                std::vector<cl::Device> parts;
+
+                /* A cpu device as several devices, a runtime like POCL supports it */
+                if((sub_devices > 1) && (device.getInfo<CL_DEVICE_TYPE>() & CL_DEVICE_TYPE_CPU))
+                {
+                    cl_uint units = device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>() / static_cast<cl_uint>(sub_devices);
+
+                    cl_device_partition_property properties[] = {CL_DEVICE_PARTITION_EQUALLY, static_cast<cl_device_partition_property>(std::max<cl_uint>(units, 1)), 0};
+
+                    try
+                    {
+                        device.createSubDevices(properties, &parts);
+                    }
+                    catch(cl::Error &e)
+                    {
+                        spdlog::warn("Device {} can't be partitioned: {}", name, e.what());
+                        parts.clear();
+                    }
+                }
+
+                if(parts.empty())
+                {
+                    add_device(device, name);
+                    continue;
+                }
+
+                for(std::size_t i = 0; i < parts.size(); i++)
+                {
+                    add_device(parts[i], name + " (sub-device " + std::to_string(i) + ")");
+                }
+            }
+        }
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+
+    if(devices.empty())
+    {
+        spdlog::error("No usable OpenCL devices found.");
+    }
+}
+
+void compute_multi_device::add_device(cl::Device const &device, std::string const &name)
+{
+    try
+    {
+        device_context dc;
+        dc.name    = name;
+        dc.device  = device;
+        dc.context = cl::Context({device});
+
+        cl::Program::Sources sources;
+
+        for(auto &kern : kernels)
+        {
+            sources.push_back({kern.c_str(), kern.length()});
+        }
+
+        dc.program = cl::Program(dc.context, sources);
+
+        try
+        {
+            dc.program.build({device});
+        }
+        catch(cl::BuildError &err)
+        {
+            spdlog::warn("Device {} skipped, OpenCL build error: {}", name, dc.program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device));
+            return;
+        }
+
+        dc.pool = opencl_pool(dc.context, device, dc.program);
+
+        spdlog::info("Using OpenCL device: {}", name);
+
+        devices.push_back(dc);
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::warn("Device {} skipped, OpenCL error: {} ({})", name, e.what(), e.err());
+    }
+}
+
+void compute_multi_device::print_info()
+{
+    try
+    {
+        for(auto &dc : devices)
+        {
+            spdlog::info(
+                "Device {}: {} compute units, {} MHz, {} MiB global memory",
+                dc.name,
+                dc.device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>(),
+                dc.device.getInfo<CL_DEVICE_MAX_CLOCK_FREQUENCY>(),
+                dc.device.getInfo<CL_DEVICE_GLOBAL_MEM_SIZE>() / (1024 * 1024));
+        }
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+}
+
+void compute_multi_device::set_operations(std::vector<std::string> const &operations)
+{
+    this->operations = operations;
+}
+
+std::vector<std::size_t> compute_multi_device::get_capacities(std::size_t const &size)
+{
+    /*
+        get_rate_shares gives at least shard_min_share before the shares are normalized (divided by at most
+        1 + devices * shard_min_share), balance_shares averages such shares and get_bounds aligns a shard down
+    */
+    double min_share         = shard_min_share / (1 + static_cast<double>(devices.size()) * shard_min_share);
+    std::size_t min_elements = static_cast<std::size_t>(min_share * static_cast<double>(size));
+    std::size_t min_shard    = (min_elements > shard_alignment) ? (min_elements - shard_alignment) : 0;
+    std::size_t largest      = size - std::min(size, (devices.size() - 1) * min_shard);
+
+    std::vector<std::size_t> capacities;
+
+    for(auto &dc : devices)
+    {
+        cl_ulong max_alloc   = dc.device.getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>();
+        cl_ulong global_size = dc.device.getInfo<CL_DEVICE_GLOBAL_MEM_SIZE>() / 3;
+        std::size_t limit    = static_cast<std::size_t>(std::min(max_alloc, global_size) / sizeof(float));
+
+        capacities.push_back(std::min(largest, (limit / shard_alignment) * shard_alignment));
+    }
+
+    return capacities;
+}
+
+std::vector<std::size_t> compute_multi_device::get_bounds(std::vector<double> const &shares, std::vector<std::size_t> const &capacities, std::size_t const &size)
+{
+    std::vector<std::size_t> lengths(shares.size(), 0);
+
+    std::size_t assigned = 0;
+
+    for(std::size_t d = 0; d < shares.size(); d++)
+    {
+        std::size_t length = static_cast<std::size_t>(shares[d] * static_cast<double>(size));
+
+        lengths[d]  = std::min({(length / shard_alignment) * shard_alignment, capacities[d], size - assigned});
+        assigned   += lengths[d];
+    }
+
+    /* The rest of the alignment and of the shards over a capacity goes to the devices with room, the last one first */
+    for(std::size_t d = shares.size(); (d > 0) && (assigned < size); d--)
+    {
+        std::size_t length = std::min(size - assigned, capacities[d - 1] - lengths[d - 1]);
+
+        lengths[d - 1] += length;
+        assigned       += length;
+    }
+
+    std::vector<std::size_t> bounds(shares.size() + 1, 0);
+
+    for(std::size_t d = 0; d < shares.size(); d++)
+    {
+        bounds[d + 1] = bounds[d] + lengths[d];
+    }
+
+    return bounds;
+}
+
+void compute_multi_device::run_all()
+{
+    if(devices.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        /* The kernels are float4 work items */
+        std::size_t size = vector_size - (vector_size % 4);
+
+        huge_page_vector<float> vec_a(size);
+        huge_page_vector<float> vec_b(size);
+        huge_page_vector<float> vec_c(size);
+
+        fill_vectors(vec_a.begin(), vec_a.end(), vec_b.begin(), vec_b.end());
+        first_touch(vec_c.begin(), vec_c.end());
+
+        for_each_operation(
+            [&](auto op)
+            {
+                typedef decltype(op) operation;
+
+                if(!is_operation_selected(operations, operation::key))
+                {
+                    return;
+                }
+
+                /* The reductions have no OpenCL kernels */
+                if constexpr(operation::kind != OPERATION_REDUCTION)
+                {
+                    _run<operation>(vec_a, vec_b, vec_c);
+                }
+            });
+
+        for(auto &dc : devices)
+        {
+            spdlog::info("Device {}:", dc.name);
+            dc.pool.report();
+        }
+    }
+    catch(cl::Error &e)
+    {
+        spdlog::error("OpenCL error: {}", e.what());
+        spdlog::error(e.err());
+    }
+}
@@ -0,0 +1,306 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Compute one vector on every OpenCL device of every platform
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_COMPUTE_MULTI_DEVICE_H
+#define COMPUTE_COMPUTE_MULTI_DEVICE_H
+
+// clang-format off
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_TARGET_OPENCL_VERSION  120
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+
+#if defined(__APPLE__) || defined(__MACOSX)
+	#include <OpenCL/cl.hpp>
+#else
+	#include <CL/cl.h>
+#endif
+// clang-format on
+
+#include "compute/fill_vectors.h"
+#include "compute/opencl_pool.h"
+#include "compute/operations.h"
+#include "compute/split_balance.h"
+#include "core/execution_time.h"
+#include "core/huge_page_allocator.h"
+#include "io/kernel_loader.h"
+#include "io/log/logger.h"
+
+#include <CL/opencl.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/*
+    Every elementwise float operation runs on one vector sharded across every usable
+    OpenCL device of every platform (cpu devices may be partitioned into sub-devices).
+    Each device has its own context, program and pool. The shards start from a
+    calibration run of every device alone and follow the throughput measured in
+    every iteration, so all devices finish at about the same time
+*/
+class compute_multi_device
+{
+public:
+    /* sub_devices > 1 partitions every cpu device into that many sub-devices (CL_DEVICE_PARTITION_EQUALLY) */
+    compute_multi_device(std::size_t const &vector_size, std::size_t const &iteration_count, std::size_t const &sub_devices);
+
+    void print_info();
+
+    void run_all();
+
+    /* Keys of the operations to run (see compute/operations.h), every operation if empty */
+    void set_operations(std::vector<std::string> const &operations);
+
+private:
+    struct device_context
+    {
+        std::string name;
+        cl::Device device;
+        cl::Context context;
+        cl::Program program;
+        opencl_pool pool;
+    };
+
+    std::vector<device_context> devices;
+    std::vector<std::string> kernels;
+    std::size_t vector_size     = 102400000;
+    std::size_t iteration_count = 100;
+    std::vector<std::string> operations;
+
+    /* A shard starts at a multiple of shard_alignment elements (float4 work items) */
+    static constexpr std::size_t shard_alignment = 4096;
+
+    /* No device gets less than this share of the vector, so every device keeps being measured */
+    static constexpr double shard_min_share = 1.0 / 64;
+
+    /* Elements every device computes alone before the shards are set */
+    static constexpr std::size_t calibration_size = 1 << 22;
+
+    /* Build the program for the device and keep it, a device that can't build it is skipped */
+    void add_device(cl::Device const &device, std::string const &name);
+
+    /*
+        Elements of the largest shard every device holds: the whole vector but the smallest shards
+        get_rate_shares and balance_shares leave to the other devices, within CL_DEVICE_MAX_MEM_ALLOC_SIZE and
+        a third of CL_DEVICE_GLOBAL_MEM_SIZE (a, b and c of a binary operation)
+    */
+    std::vector<std::size_t> get_capacities(std::size_t const &size);
+
+    /*
+        Shard boundaries of size elements, device d computes [bounds[d], bounds[d + 1]),
+        no shard is larger than the capacity of its device (the rest moves to devices with room)
+    */
+    std::vector<std::size_t> get_bounds(std::vector<double> const &shares, std::vector<std::size_t> const &capacities, std::size_t const &size);
+
+    /*
+        c = operation(a, b) or c = operation(a) iteration_count times, the shards of
+        the devices run at the same time, the inputs of every shard are written and
+        its result read back every iteration
+    */
+    template<typename operation>
+    void _run(huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> &vec_c);
+
+    /*
+        One pass over the shards, every device writes its part of the inputs to the start of its buffers
+        (capacities elements), computes and reads back its part of c, seconds gets the device time of
+        every shard (the first write to the end of the read)
+    */
+    template<typename operation>
+    void _pass(
+        std::vector<std::size_t> const &bounds,
+        std::vector<std::size_t> const &capacities,
+        huge_page_vector<float> const &vec_a,
+        huge_page_vector<float> const &vec_b,
+        huge_page_vector<float> &vec_c,
+        std::vector<double> &seconds);
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename operation>
+void compute_multi_device::_run(huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> &vec_c)
+{
+    constexpr std::size_t bytes_per_element = get_operation_streams<operation>() * sizeof(float);
+
+    std::size_t size = vec_c.size();
+
+    spdlog::info("Multi-device application: {} (kernel: {}, {} devices)", operation::name, operation::opencl_kernel, devices.size());
+
+    std::vector<std::size_t> capacities = get_capacities(size);
+
+    std::size_t capacity = 0;
+
+    for(std::size_t d = 0; d < devices.size(); d++)
+    {
+        capacity += capacities[d];
+    }
+
+    if(capacity < size)
+    {
+        spdlog::error("Multi-device application: {} elements don't fit the devices (at most {} elements)", size, capacity);
+        return;
+    }
+
+    std::vector<double> seconds(devices.size(), 0);
+    std::vector<double> rates(devices.size(), 0);
+
+    /* Every device alone on the start of the vector, this also creates the buffers and kernels */
+    for(std::size_t d = 0; d < devices.size(); d++)
+    {
+        std::size_t calibration = std::min({size, calibration_size, capacities[d]});
+
+        std::vector<std::size_t> bounds(devices.size() + 1, 0);
+
+        for(std::size_t i = d + 1; i <= devices.size(); i++)
+        {
+            bounds[i] = calibration;
+        }
+
+        _pass<operation>(bounds, capacities, vec_a, vec_b, vec_c, seconds);
+
+        rates[d] = (seconds[d] > 0) ? static_cast<double>(calibration) / seconds[d] : 0;
+    }
+
+    std::vector<double> shares = get_rate_shares(rates, shard_min_share);
+
+    std::vector<double> device_seconds(devices.size(), 0);
+    std::vector<double> device_elements(devices.size(), 0);
+    std::vector<double> first_shares = shares;
+
+    execution_time et;
+    et.start();
+
+    for(std::size_t n = 0; n < iteration_count; n++)
+    {
+        std::vector<std::size_t> bounds = get_bounds(shares, capacities, size);
+
+        _pass<operation>(bounds, capacities, vec_a, vec_b, vec_c, seconds);
+
+        for(std::size_t d = 0; d < devices.size(); d++)
+        {
+            double elements = static_cast<double>(bounds[d + 1] - bounds[d]);
+
+            rates[d]            = (seconds[d] > 0) ? elements / seconds[d] : 0;
+            device_seconds[d]  += seconds[d];
+            device_elements[d] += elements;
+        }
+
+        shares = balance_shares(shares, rates, shard_min_share);
+    }
+
+    et.stop();
+
+    double wall  = static_cast<double>(et.count_nanoseconds()) / 1e9;
+    double total = static_cast<double>(size) * static_cast<double>(iteration_count);
+    double sum   = 0;
+
+    spdlog::info("Time to multi-device compute: {} (milliseconds)", et.count_milliseconds());
+
+    for(std::size_t d = 0; d < devices.size(); d++)
+    {
+        double rate = (device_seconds[d] > 0) ? device_elements[d] / device_seconds[d] : 0;
+
+        sum += rate;
+
+        spdlog::info(
+            "Device {}: share {:.1f}% at the start, {:.1f}% at the end, {:.3f} Gelements/s, {:.3f} (milliseconds busy)",
+            devices[d].name,
+            first_shares[d] * 100,
+            shares[d] * 100,
+            rate / 1e9,
+            device_seconds[d] * 1e3);
+    }
+
+    if(wall > 0)
+    {
+        spdlog::info("Multi-device throughput: {:.3f} Gelements/s, {:.3f} GB/s", total / wall / 1e9, total * bytes_per_element / wall / 1e9);
+
+        /* Below 100% the devices wait for each other or for the host */
+        if(sum > 0)
+        {
+            spdlog::info("Multi-device efficiency: {:.1f}% of the sum of the device throughputs", total / wall / sum * 100);
+        }
+    }
+
+    verify_split<operation>("Multi-device", vec_a, vec_b, vec_c);
+}
+
+template<typename operation>
+void compute_multi_device::_pass(
+    std::vector<std::size_t> const &bounds,
+    std::vector<std::size_t> const &capacities,
+    huge_page_vector<float> const &vec_a,
+    huge_page_vector<float> const &vec_b,
+    huge_page_vector<float> &vec_c,
+    std::vector<double> &seconds)
+{
+    constexpr bool binary = (operation::kind == OPERATION_BINARY);
+
+    std::vector<cl::Event> write_events(devices.size());
+    std::vector<cl::Event> read_events(devices.size());
+
+    /* Everything is queued on every device first, then the devices run at the same time */
+    for(std::size_t d = 0; d < devices.size(); d++)
+    {
+        std::size_t begin = bounds[d];
+        std::size_t end   = bounds[d + 1];
+
+        if(begin == end)
+        {
+            continue;
+        }
+
+        std::size_t bytes = capacities[d] * sizeof(float);
+
+        /* The buffers hold the largest shard of the device, the shards move between iterations; unary operations don't read b */
+        opencl_pool &pool       = devices[d].pool;
+        cl::Buffer &buffer_a    = pool.get_buffer(bytes, CL_MEM_READ_ONLY, 0);
+        cl::Buffer &buffer_b    = binary ? pool.get_buffer(bytes, CL_MEM_READ_ONLY, 1) : buffer_a;
+        cl::Buffer &buffer_c    = pool.get_buffer(bytes, CL_MEM_WRITE_ONLY, 0);
+        cl::Kernel &kernel      = pool.get_kernel(operation::opencl_kernel);
+        cl::CommandQueue &queue = pool.get_queue();
+
+        set_shard_arguments<operation>(kernel, buffer_a, buffer_b, buffer_c);
+
+        /* The shard is at the start of the buffers */
+        enqueue_shard<operation>(queue, kernel, cl::NullRange, buffer_a, buffer_b, buffer_c, vec_a, vec_b, vec_c, begin, end, begin, write_events[d], read_events[d]);
+    }
+
+    for(std::size_t d = 0; d < devices.size(); d++)
+    {
+        seconds[d] = 0;
+
+        if(bounds[d] == bounds[d + 1])
+        {
+            continue;
+        }
+
+        seconds[d] = get_shard_seconds(write_events[d], read_events[d]);
+    }
+}
+
+#endif // COMPUTE_COMPUTE_MULTI_DEVICE_H
@@ -0,0 +1,335 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Expression templates that fuse chains of CPU vector operations into a single pass
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_EXPRESSION_H
+#define COMPUTE_EXPRESSION_H
+
+#include "compute/simd/simd_kernels.h"
+#include "core/huge_page_allocator.h"
+#include "core/parallel_for.h"
+#include "core/settings.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/*
+    Usage:
+        expression_terminal a(vec_a.data());
+        expression_terminal b(vec_b.data());
+        evaluate(vec_c.data(), vec_c.size(), (a + b) * (a + b), LOG_ACCURACY_ACCURATE);
+
+    Operators only build a tree of types, nothing is computed until evaluate().
+    evaluate() walks the vectors in blocks of expression_block_size elements.
+    Every node of the tree is applied to a block with the dispatched SIMD
+    kernels while the block is still in L1, so the whole chain costs one read
+    of every input and one write of the result.
+
+    evaluate_unfused() computes the same tree one full pass per node with
+    temporary vectors (the way separate calls to compute_cpu work), it is
+    the baseline for the fusion benchmark.
+*/
+
+/* Elements processed by one node at a time (4 KiB of floats) */
+constexpr std::size_t expression_block_size = 1024;
+
+template<typename derived>
+struct expression
+{
+    derived const &self() const
+    {
+        return static_cast<derived const &>(*this);
+    }
+};
+
+/*
+    Every node provides:
+        temporaries - count of scratch blocks it needs besides the output block
+        operations - count of operations (passes of the unfused evaluation)
+        streams - vectors read and written by the unfused evaluation
+        eval(begin, count, out, scratch, accuracy) - computes elements [begin, begin + count) into out
+            and returns a pointer to the results (a terminal returns its own data instead)
+        materialize(size, out, workspace, index, accuracy) - same as eval but for the whole vector
+    accuracy selects the logarithm the same way compute_cpu does for its operations
+*/
+class expression_terminal : public expression<expression_terminal>
+{
+public:
+    static constexpr bool is_terminal        = true;
+    static constexpr std::size_t temporaries = 0;
+    static constexpr std::size_t operations  = 0;
+    static constexpr std::size_t streams     = 0;
+
+    explicit expression_terminal(float const *data) : data(data) {}
+
+    float const *eval(std::size_t begin, std::size_t, float *, float *, log_accuracy const &) const
+    {
+        return data + begin;
+    }
+
+    float const *materialize(std::size_t, float *, std::vector<huge_page_vector<float>> &, std::size_t &, log_accuracy const &) const
+    {
+        return data;
+    }
+
+private:
+    float const *data;
+};
+
+/* Operation tags */
+struct expression_addition
+{
+    static simd_binary_kernel kernel(simd_kernel_table const &table, log_accuracy const &)
+    {
+        return table.addition;
+    }
+};
+
+struct expression_remove
+{
+    static simd_binary_kernel kernel(simd_kernel_table const &table, log_accuracy const &)
+    {
+        return table.remove;
+    }
+};
+
+struct expression_multiple
+{
+    static simd_binary_kernel kernel(simd_kernel_table const &table, log_accuracy const &)
+    {
+        return table.multiple;
+    }
+};
+
+struct expression_divide
+{
+    static simd_binary_kernel kernel(simd_kernel_table const &table, log_accuracy const &)
+    {
+        return table.divide;
+    }
+};
+
+struct expression_log
+{
+    static simd_unary_kernel kernel(simd_kernel_table const &table, log_accuracy const &accuracy)
+    {
+        switch(accuracy)
+        {
+            case LOG_ACCURACY_FAST:
+                return table.log_fast;
+            case LOG_ACCURACY_ACCURATE:
+                return table.log_accurate;
+            case LOG_ACCURACY_STD:
+            default:
+                return table.log;
+        }
+    }
+};
+
+/* Parallel pass of a kernel over whole vectors (one step of the unfused evaluation) */
+template<typename kernel_type, typename... argument_types>
+void expression_pass(kernel_type kernel, std::size_t size, argument_types... arguments)
+{
+    parallel_for(
+        0,
+        size,
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
+        {
+            kernel(arguments + begin..., end - begin);
+        });
+}
+
+/* Takes the next temporary vector of the workspace (terminals don't need one) */
+template<typename node_type>
+float *expression_temporary(std::size_t size, std::vector<huge_page_vector<float>> &workspace, std::size_t &index)
+{
+    if(node_type::is_terminal)
+    {
+        return nullptr;
+    }
+
+    if(index == workspace.size())
+    {
+        workspace.emplace_back(size);
+    }
+
+    workspace[index].resize(size);
+    return workspace[index++].data();
+}
+
+template<typename operation, typename left_type, typename right_type>
+class expression_binary : public expression<expression_binary<operation, left_type, right_type>>
+{
+public:
+    /* The left operand is computed into the output block, the right one into the first scratch block */
+    static constexpr bool is_terminal        = false;
+    static constexpr std::size_t temporaries = std::max(left_type::temporaries, 1 + right_type::temporaries);
+    static constexpr std::size_t operations  = 1 + left_type::operations + right_type::operations;
+    static constexpr std::size_t streams     = 3 + left_type::streams + right_type::streams;
+
+    expression_binary(left_type const &left, right_type const &right) : left(left), right(right) {}
+
+    float const *eval(std::size_t begin, std::size_t count, float *out, float *scratch, log_accuracy const &accuracy) const
+    {
+        float const *x = left.eval(begin, count, out, scratch, accuracy);
+        float const *y = right.eval(begin, count, scratch, scratch + expression_block_size, accuracy);
+
+        operation::kernel(simd_kernels::instance().get(), accuracy)(x, y, out, count);
+        return out;
+    }
+
+    float const *materialize(std::size_t size, float *out, std::vector<huge_page_vector<float>> &workspace, std::size_t &index, log_accuracy const &accuracy) const
+    {
+        float const *x = left.materialize(size, expression_temporary<left_type>(size, workspace, index), workspace, index, accuracy);
+        float const *y = right.materialize(size, expression_temporary<right_type>(size, workspace, index), workspace, index, accuracy);
+
+        expression_pass(operation::kernel(simd_kernels::instance().get(), accuracy), size, x, y, out);
+        return out;
+    }
+
+private:
+    left_type left;
+    right_type right;
+};
+
+template<typename operation, typename argument_type>
+class expression_unary : public expression<expression_unary<operation, argument_type>>
+{
+public:
+    /* The argument is computed into the output block and transformed in place */
+    static constexpr bool is_terminal        = false;
+    static constexpr std::size_t temporaries = argument_type::temporaries;
+    static constexpr std::size_t operations  = 1 + argument_type::operations;
+    static constexpr std::size_t streams     = 2 + argument_type::streams;
+
+    explicit expression_unary(argument_type const &argument) : argument(argument) {}
+
+    float const *eval(std::size_t begin, std::size_t count, float *out, float *scratch, log_accuracy const &accuracy) const
+    {
+        float const *x = argument.eval(begin, count, out, scratch, accuracy);
+
+        operation::kernel(simd_kernels::instance().get(), accuracy)(x, out, count);
+        return out;
+    }
+
+    float const *materialize(std::size_t size, float *out, std::vector<huge_page_vector<float>> &workspace, std::size_t &index, log_accuracy const &accuracy) const
+    {
+        float const *x = argument.materialize(size, expression_temporary<argument_type>(size, workspace, index), workspace, index, accuracy);
+
+        expression_pass(operation::kernel(simd_kernels::instance().get(), accuracy), size, x, out);
+        return out;
+    }
+
+private:
+    argument_type argument;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename left_type, typename right_type>
+expression_binary<expression_addition, left_type, right_type> operator+(expression<left_type> const &left, expression<right_type> const &right)
+{
+    return {left.self(), right.self()};
+}
+
+template<typename left_type, typename right_type>
+expression_binary<expression_remove, left_type, right_type> operator-(expression<left_type> const &left, expression<right_type> const &right)
+{
+    return {left.self(), right.self()};
+}
+
+template<typename left_type, typename right_type>
+expression_binary<expression_multiple, left_type, right_type> operator*(expression<left_type> const &left, expression<right_type> const &right)
+{
+    return {left.self(), right.self()};
+}
+
+template<typename left_type, typename right_type>
+expression_binary<expression_divide, left_type, right_type> operator/(expression<left_type> const &left, expression<right_type> const &right)
+{
+    return {left.self(), right.self()};
+}
+
+/* Natural logarithm (which one is chosen by the accuracy passed to evaluate) */
+template<typename argument_type>
+expression_unary<expression_log, argument_type> log(expression<argument_type> const &argument)
+{
+    return expression_unary<expression_log, argument_type>(argument.self());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/* Fused: destination[i] = e(i) for i in [0, size), one parallel pass */
+template<typename expression_type>
+void evaluate(float *destination, std::size_t size, expression<expression_type> const &e, log_accuracy const &accuracy)
+{
+    expression_type const &root = e.self();
+
+    /* Ranges of several blocks, so the scratch blocks are set up once per range */
+    parallel_for(
+        0,
+        size,
+        parallel_for_grain,
+        [&](std::size_t range_begin, std::size_t range_end)
+        {
+            /* At least one element so the array is never empty */
+            std::array<float, (expression_type::temporaries + 1) * expression_block_size> scratch;
+
+            for(std::size_t begin = range_begin; begin < range_end; begin += expression_block_size)
+            {
+                std::size_t count = std::min(expression_block_size, range_end - begin);
+
+                float const *result = root.eval(begin, count, destination + begin, scratch.data(), accuracy);
+
+                /* Only a bare terminal returns something else than the output block */
+                if(result != destination + begin)
+                {
+                    std::memcpy(destination + begin, result, count * sizeof(float));
+                }
+            }
+        });
+}
+
+/*
+    Unfused: every node is a separate parallel pass over whole vectors
+    Temporary vectors are taken from workspace, so repeated calls don't allocate
+*/
+template<typename expression_type>
+void evaluate_unfused(float *destination, std::size_t size, expression<expression_type> const &e, std::vector<huge_page_vector<float>> &workspace, log_accuracy const &accuracy)
+{
+    std::size_t index   = 0;
+    float const *result = e.self().materialize(size, destination, workspace, index, accuracy);
+
+    if(result != destination)
+    {
+        std::memcpy(destination, result, size * sizeof(float));
+    }
+}
+
+#endif // COMPUTE_EXPRESSION_H
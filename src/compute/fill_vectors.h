@@ -27,9 +27,41 @@
 #ifndef COMPUTE_FILL_VECTORS_H
 #define COMPUTE_FILL_VECTORS_H
 
+#include "compute/half_types.h"
+#include "core/parallel_for.h"
+
 #include <iterator>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+/*
+    Test values: i / 2 and i * 2 for float and double, the same within the
+    binary16 range for the half precision types, and small nonzero values
+    for the integer types (no division by zero and no overflow of uint8)
+*/
+template<typename data_type>
+data_type fill_value_a(std::size_t const &i)
+{
+    if constexpr(std::is_integral<data_type>::value)
+        return static_cast<data_type>(1 + (i % 127));
+    else if constexpr(is_half_type<data_type>::value)
+        return data_type((float)(i % 4096) / 2);
+    else
+        return static_cast<data_type>((float)i / 2);
+}
+
+template<typename data_type>
+data_type fill_value_b(std::size_t const &i)
+{
+    if constexpr(std::is_integral<data_type>::value)
+        return static_cast<data_type>(1 + ((i * 2) % 127));
+    else if constexpr(is_half_type<data_type>::value)
+        return data_type((float)(i % 4096) * 2);
+    else
+        return static_cast<data_type>((float)i * 2);
+}
+
 template<typename iterator_type>
 void fill_vectors(iterator_type start_iterator_a, iterator_type end_iterator_a, iterator_type start_iterator_b, iterator_type end_iterator_b)
 {
@@ -40,24 +72,48 @@ void fill_vectors(iterator_type start_iterator_a, iterator_type end_iterator_a,
     std::size_t size_of_b = sizeof(data_type) * (end_iterator_b - start_iterator_b);
 
     std::size_t size_a = sizeof(data_size) * (end_iterator_a - start_iterator_a);
-    std::size_t size_b = sizeof(data_size) * (end_iterator_b - start_iterator_b);
 
     if(size_of_a != size_of_b)
     {
         throw std::logic_error("Iterators are not equal.");
     }
 
-#pragma omp parallel for
-    for(std::size_t i = 0; i < size_a; i++)
-    {
-        start_iterator_a[i] = (float)i / 2;
-    }
+    /*
+        A single pass over both vectors, with the same parallel_for ranges as
+        the computation, so uninitialized vectors (see huge_page_allocator)
+        are touched first by the threads that compute on them
+    */
+    parallel_for(
+        0,
+        size_a,
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++)
+            {
+                start_iterator_a[i] = fill_value_a<data_type>(i);
+                start_iterator_b[i] = fill_value_b<data_type>(i);
+            }
+        });
+}
 
-#pragma omp parallel for
-    for(std::size_t i = 0; i < size_b; i++)
-    {
-        start_iterator_b[i] = (float)i * 2;
-    }
+/* Parallel first touch of an uninitialized result vector, writes value_type() */
+template<typename iterator_type>
+void first_touch(iterator_type start_iterator, iterator_type end_iterator)
+{
+    typedef typename std::iterator_traits<iterator_type>::value_type data_type;
+
+    parallel_for(
+        0,
+        static_cast<std::size_t>(end_iterator - start_iterator),
+        parallel_for_grain,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; i++)
+            {
+                start_iterator[i] = data_type();
+            }
+        });
 }
 
 #endif // COMPUTE_FILL_VECTORS_H
\ No newline at end of file
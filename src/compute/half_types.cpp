@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Half precision element types (IEEE binary16 and bfloat16)
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/half_types.h"
+
+#include <cstring>
+
+float float16_bits_to_float(std::uint16_t const &bits)
+{
+    std::uint32_t sign     = static_cast<std::uint32_t>(bits & 0x8000) << 16;
+    std::uint32_t exponent = (bits >> 10) & 0x1F;
+    std::uint32_t mantissa = bits & 0x03FF;
+    std::uint32_t result   = 0;
+
+    if(exponent == 0x1F)
+    {
+        /* Infinity or NaN */
+        result = sign | 0x7F800000 | (mantissa << 13);
+
+        if(mantissa != 0)
+        {
+            result |= 0x00400000;
+        }
+    }
+    else if(exponent == 0)
+    {
+        /* Zero or subnormal: mantissa * 2^-24, exact in float */
+        float value = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        std::memcpy(&result, &value, sizeof(result));
+        result |= sign;
+    }
+    else
+    {
+        result = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+std::uint16_t float_to_float16_bits(float const &value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    std::uint32_t sign      = (bits >> 16) & 0x8000;
+    std::uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    /* Infinity or NaN, NaN keeps the upper bits of the payload */
+    if(magnitude >= 0x7F800000)
+    {
+        std::uint32_t nan = (magnitude > 0x7F800000) ? (0x0200 | ((magnitude >> 13) & 0x03FF)) : 0;
+        return static_cast<std::uint16_t>(sign | 0x7C00 | nan);
+    }
+
+    /* 65520 and above round to infinity */
+    if(magnitude >= 0x477FF000)
+    {
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+    }
+
+    /* Normal result: rebias the exponent (127 - 15) and round the 13 dropped bits, the carry may reach the exponent */
+    if(magnitude >= 0x38800000)
+    {
+        std::uint32_t odd = (magnitude >> 13) & 1;
+        return static_cast<std::uint16_t>(sign | ((magnitude - 0x38000000 + 0x0FFF + odd) >> 13));
+    }
+
+    /* Below 2^-25 rounds to zero */
+    std::uint32_t exponent = magnitude >> 23;
+    if(exponent < 102)
+    {
+        return static_cast<std::uint16_t>(sign);
+    }
+
+    /* Subnormal result in units of 2^-24 */
+    std::uint32_t mantissa = (magnitude & 0x007FFFFF) | 0x00800000;
+    std::uint32_t shift    = 126 - exponent;
+    std::uint32_t result   = mantissa >> shift;
+    std::uint32_t rest     = mantissa & ((1u << shift) - 1);
+    std::uint32_t half     = 1u << (shift - 1);
+
+    if((rest > half) || ((rest == half) && ((result & 1) != 0)))
+    {
+        result++;
+    }
+
+    return static_cast<std::uint16_t>(sign | result);
+}
+
+float bfloat16_bits_to_float(std::uint16_t const &bits)
+{
+    std::uint32_t result = static_cast<std::uint32_t>(bits) << 16;
+
+    float value;
+    std::memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+std::uint16_t float_to_bfloat16_bits(float const &value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    /* NaN: quiet it, rounding could turn it into infinity */
+    if((bits & 0x7FFFFFFF) > 0x7F800000)
+    {
+        return static_cast<std::uint16_t>((bits >> 16) | 0x0040);
+    }
+
+    std::uint32_t odd = (bits >> 16) & 1;
+    return static_cast<std::uint16_t>((bits + 0x7FFF + odd) >> 16);
+}
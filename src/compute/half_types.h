@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Half precision element types (IEEE binary16 and bfloat16)
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_HALF_TYPES_H
+#define COMPUTE_HALF_TYPES_H
+
+#include <cstdint>
+#include <type_traits>
+
+/*
+    Scalar conversions, rounding to nearest even like the SIMD conversion
+    kernels (see simd_kernel_table), NaN stays a quiet NaN
+*/
+float float16_bits_to_float(std::uint16_t const &bits);
+std::uint16_t float_to_float16_bits(float const &value);
+float bfloat16_bits_to_float(std::uint16_t const &bits);
+std::uint16_t float_to_bfloat16_bits(float const &value);
+
+/* IEEE 754 binary16: 5 bit exponent, 10 bit mantissa. Storage only, arithmetic goes through float */
+struct float16
+{
+    std::uint16_t bits;
+
+    float16() = default;
+
+    float16(float const &value) : bits(float_to_float16_bits(value)) {}
+
+    operator float() const
+    {
+        return float16_bits_to_float(bits);
+    }
+};
+
+/* bfloat16: the upper half of a float, 8 bit exponent, 7 bit mantissa. Storage only */
+struct bfloat16
+{
+    std::uint16_t bits;
+
+    bfloat16() = default;
+
+    bfloat16(float const &value) : bits(float_to_bfloat16_bits(value)) {}
+
+    operator float() const
+    {
+        return bfloat16_bits_to_float(bits);
+    }
+};
+
+/* Types that are computed by converting blocks to float */
+template<typename data_type>
+struct is_half_type : std::integral_constant<bool, std::is_same<data_type, float16>::value || std::is_same<data_type, bfloat16>::value>
+{
+};
+
+#endif // COMPUTE_HALF_TYPES_H
@@ -0,0 +1,27 @@
+__kernel void roofline_flops(__global float *c, float m, float b, int iterations)
+{
+    int index = get_global_id(0);
+    float x0  = index;
+    float x1  = x0 + 1.0f;
+    float x2  = x0 + 2.0f;
+    float x3  = x0 + 3.0f;
+    float x4  = x0 + 4.0f;
+    float x5  = x0 + 5.0f;
+    float x6  = x0 + 6.0f;
+    float x7  = x0 + 7.0f;
+
+    /* 8 independent chains of 2 FLOPs */
+    for(int i = 0; i < iterations; i++)
+    {
+        x0 = mad(x0, m, b);
+        x1 = mad(x1, m, b);
+        x2 = mad(x2, m, b);
+        x3 = mad(x3, m, b);
+        x4 = mad(x4, m, b);
+        x5 = mad(x5, m, b);
+        x6 = mad(x6, m, b);
+        x7 = mad(x7, m, b);
+    }
+
+    c[index] = x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7;
+};
\ No newline at end of file
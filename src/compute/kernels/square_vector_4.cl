@@ -0,0 +1,5 @@
+__kernel void square_vector_4(__global const float4 *a, __global float4 *c)
+{
+    int index = get_global_id(0);
+    c[index]  = a[index] * a[index];
+};
\ No newline at end of file
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief OpenCL command queues, kernels and device buffers kept between compute_gpu runs
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/opencl_pool.h"
+
+#include "core/execution_time.h"
+#include "io/log/logger.h"
+
+opencl_pool::opencl_pool(cl::Context const &context, cl::Device const &device, cl::Program const &program)
+{
+    this->context = context;
+    this->device  = device;
+    this->program = program;
+}
+
+cl::CommandQueue &opencl_pool::get_queue(std::size_t const &index)
+{
+    auto it = queues.find(index);
+
+    if(it != queues.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    execution_time et;
+    et.start();
+
+    cl::CommandQueue &queue = queues.emplace(index, cl::CommandQueue(context, device, CL_QUEUE_PROFILING_ENABLE)).first->second;
+
+    et.stop();
+
+    misses++;
+    setup_seconds += static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    return queue;
+}
+
+cl::Kernel &opencl_pool::get_kernel(std::string const &name)
+{
+    auto it = kernels.find(name);
+
+    if(it != kernels.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    execution_time et;
+    et.start();
+
+    cl::Kernel &kernel = kernels.emplace(name, cl::Kernel(program, name.c_str())).first->second;
+
+    et.stop();
+
+    misses++;
+    setup_seconds += static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    return kernel;
+}
+
+cl::Buffer &opencl_pool::get_buffer(std::size_t const &size, cl_mem_flags const &flags, std::size_t const &index)
+{
+    auto key = std::make_tuple(size, flags, index);
+    auto it  = buffers.find(key);
+
+    if(it != buffers.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    execution_time et;
+    et.start();
+
+    cl::Buffer &buffer = buffers.emplace(key, cl::Buffer(context, flags, size)).first->second;
+
+    et.stop();
+
+    misses++;
+    buffer_size   += size;
+    setup_seconds += static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    return buffer;
+}
+
+double opencl_pool::take_setup_seconds()
+{
+    double seconds = setup_seconds;
+
+    total_seconds += setup_seconds;
+    setup_seconds  = 0;
+
+    return seconds;
+}
+
+void opencl_pool::report() const
+{
+    spdlog::info(
+        "OpenCL pool: {} buffers ({} MiB), {} kernels, {} queues, {} objects reused, {} created",
+        buffers.size(),
+        buffer_size / (1024 * 1024),
+        kernels.size(),
+        queues.size(),
+        hits,
+        misses);
+    spdlog::info("OpenCL pool: {:.3f} (milliseconds) creating objects", (total_seconds + setup_seconds) * 1e3);
+}
+
+void opencl_pool::release_buffers()
+{
+    buffers.clear();
+    buffer_size = 0;
+}
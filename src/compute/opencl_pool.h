@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief OpenCL command queues, kernels and device buffers kept between compute_gpu runs
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_OPENCL_POOL_H
+#define COMPUTE_OPENCL_POOL_H
+
+// clang-format off
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_TARGET_OPENCL_VERSION  120
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+
+#if defined(__APPLE__) || defined(__MACOSX)
+	#include <OpenCL/cl.hpp>
+#else
+	#include <CL/cl.h>
+#endif
+// clang-format on
+
+#include <CL/opencl.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+
+/*
+    Creating buffers, kernels and queues costs more than running a kernel on
+    small vectors, and every compute_gpu run needs the same ones. The pool
+    creates each of them on first use and hands out the same object later:
+        command queues by index (with profiling, see CL_QUEUE_PROFILING_ENABLE)
+        kernels by name
+        buffers by size, flags and index (the index tells apart buffers
+        of the same size and flags used at the same time, a and b)
+    The time spent creating them is counted, so runs can report setup apart
+    from the kernels. Buffers are not shared between users at the same time,
+    a kernel has the arguments of its last user. A run that needs other buffers
+    (another transfer mode for example) releases the held ones first
+*/
+class opencl_pool
+{
+public:
+    opencl_pool() = default;
+    opencl_pool(cl::Context const &context, cl::Device const &device, cl::Program const &program);
+
+    cl::CommandQueue &get_queue(std::size_t const &index = 0);
+
+    cl::Kernel &get_kernel(std::string const &name);
+
+    cl::Buffer &get_buffer(std::size_t const &size, cl_mem_flags const &flags, std::size_t const &index = 0);
+
+    /* Seconds spent creating objects, since the start or the last call */
+    double take_setup_seconds();
+
+    /* Print the objects the pool holds, how often they were reused and the time spent creating them */
+    void report() const;
+
+    /* Release every buffer (kernels and queues stay) */
+    void release_buffers();
+
+private:
+    cl::Context context;
+    cl::Device device;
+    cl::Program program;
+
+    std::map<std::size_t, cl::CommandQueue> queues;
+    std::map<std::string, cl::Kernel> kernels;
+    std::map<std::tuple<std::size_t, cl_mem_flags, std::size_t>, cl::Buffer> buffers;
+
+    std::size_t hits        = 0;
+    std::size_t misses      = 0;
+    double setup_seconds    = 0;
+    double total_seconds    = 0;
+    std::size_t buffer_size = 0;
+};
+
+#endif // COMPUTE_OPENCL_POOL_H
@@ -0,0 +1,444 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Registry of the compute_cpu operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_OPERATIONS_H
+#define COMPUTE_OPERATIONS_H
+
+#include "compute/roofline.h"
+#include "compute/simd/simd_kernels.h"
+#include "core/settings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+    Every operation of compute_cpu is a type, compute_cpu is instantiated
+    for each of them, so there is no switch over operations at run time.
+
+    Every operation provides:
+        name - name in the log
+        key - name on the command line (--operations)
+        kind - see operation_kind
+        flops - floating point operations per element
+
+    Elementwise operations:
+        apply(a[, b]) - the scalar function, every operation and element type
+            gets its own loop of it that the compiler can vectorize
+        kernel(table, streaming, accuracy) - SIMD kernel for contiguous float
+        opencl_kernel - OpenCL kernel (float4) of the same function, used when
+            a vector is split between cpu and an OpenCL device
+
+    Reductions (float only):
+        inputs - vectors read (a, or a and b)
+        summation - the result is a sum, so pairwise and Kahan summation apply
+        kernel(table, kahan) - SIMD kernel that reduces a block
+        combine(x, y) - combines the results of two blocks
+        finish(x) - the result from the combined blocks
+        identity and accumulate(x, a, b) - serial double precision reference
+
+    A new operation is a type here and an entry in operation_registry.
+*/
+enum operation_kind
+{
+    OPERATION_BINARY,   /* c = apply(a, b) */
+    OPERATION_UNARY,    /* c = apply(a) */
+    OPERATION_REDUCTION /* One value from a (and b) */
+};
+
+struct operation_addition
+{
+    static constexpr char const *name          = "Addition";
+    static constexpr char const *key           = "addition";
+    static constexpr char const *opencl_kernel = "addition_vector_4";
+    static constexpr operation_kind kind       = OPERATION_BINARY;
+    static constexpr double flops              = 1;
+
+    template<typename T>
+    static T apply(T const &a, T const &b)
+    {
+        return a + b;
+    }
+
+    static simd_binary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &)
+    {
+        return streaming ? table.addition_stream : table.addition;
+    }
+};
+
+struct operation_remove
+{
+    static constexpr char const *name          = "Remove";
+    static constexpr char const *key           = "remove";
+    static constexpr char const *opencl_kernel = "remove_vector_4";
+    static constexpr operation_kind kind       = OPERATION_BINARY;
+    static constexpr double flops              = 1;
+
+    template<typename T>
+    static T apply(T const &a, T const &b)
+    {
+        return a - b;
+    }
+
+    static simd_binary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &)
+    {
+        return streaming ? table.remove_stream : table.remove;
+    }
+};
+
+struct operation_multiple
+{
+    static constexpr char const *name          = "Multiple";
+    static constexpr char const *key           = "multiple";
+    static constexpr char const *opencl_kernel = "multiple_vector_4";
+    static constexpr operation_kind kind       = OPERATION_BINARY;
+    static constexpr double flops              = 1;
+
+    template<typename T>
+    static T apply(T const &a, T const &b)
+    {
+        return a * b;
+    }
+
+    static simd_binary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &)
+    {
+        return streaming ? table.multiple_stream : table.multiple;
+    }
+};
+
+struct operation_divide
+{
+    static constexpr char const *name          = "Divide";
+    static constexpr char const *key           = "divide";
+    static constexpr char const *opencl_kernel = "divide_vector_4";
+    static constexpr operation_kind kind       = OPERATION_BINARY;
+    static constexpr double flops              = 1;
+
+    template<typename T>
+    static T apply(T const &a, T const &b)
+    {
+        return a / b;
+    }
+
+    static simd_binary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &)
+    {
+        return streaming ? table.divide_stream : table.divide;
+    }
+};
+
+struct operation_exponentiation
+{
+    static constexpr char const *name          = "Exponentiation";
+    static constexpr char const *key           = "exponentiation";
+    static constexpr char const *opencl_kernel = "square_vector_4";
+    static constexpr operation_kind kind       = OPERATION_UNARY;
+
+    /* a * a */
+    static constexpr double flops = 1;
+
+    template<typename T>
+    static T apply(T const &a)
+    {
+        return a * a;
+    }
+
+    static simd_unary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &)
+    {
+        return streaming ? table.exponentiation_stream : table.exponentiation;
+    }
+};
+
+struct operation_log
+{
+    static constexpr char const *name          = "Log";
+    static constexpr char const *key           = "log";
+    static constexpr char const *opencl_kernel = "log_vector_4";
+    static constexpr operation_kind kind       = OPERATION_UNARY;
+    static constexpr double flops              = roofline::log_flops;
+
+    template<typename T>
+    static T apply(T const &a)
+    {
+        return std::log(a);
+    }
+
+    static simd_unary_kernel kernel(simd_kernel_table const &table, bool const &streaming, log_accuracy const &accuracy)
+    {
+        switch(accuracy)
+        {
+            case LOG_ACCURACY_FAST:
+                return streaming ? table.log_fast_stream : table.log_fast;
+            case LOG_ACCURACY_ACCURATE:
+                return streaming ? table.log_accurate_stream : table.log_accurate;
+            case LOG_ACCURACY_STD:
+            default:
+                return streaming ? table.log_stream : table.log;
+        }
+    }
+};
+
+struct operation_sum
+{
+    static constexpr char const *name    = "Sum";
+    static constexpr char const *key     = "sum";
+    static constexpr operation_kind kind = OPERATION_REDUCTION;
+    static constexpr double flops        = 1;
+    static constexpr std::size_t inputs  = 1;
+    static constexpr bool summation      = true;
+    static constexpr double identity     = 0;
+
+    static simd_reduce_kernel kernel(simd_kernel_table const &table, bool const &kahan)
+    {
+        return kahan ? table.sum_kahan : table.sum;
+    }
+
+    static float combine(float x, float y)
+    {
+        return x + y;
+    }
+
+    template<typename T>
+    static T finish(T const &x)
+    {
+        return x;
+    }
+
+    static double accumulate(double const &x, double const &a, double const &)
+    {
+        return x + a;
+    }
+};
+
+struct operation_min
+{
+    static constexpr char const *name    = "Min";
+    static constexpr char const *key     = "min";
+    static constexpr operation_kind kind = OPERATION_REDUCTION;
+    static constexpr double flops        = 1;
+    static constexpr std::size_t inputs  = 1;
+    static constexpr bool summation      = false;
+    static constexpr double identity     = std::numeric_limits<double>::infinity();
+
+    static simd_reduce_kernel kernel(simd_kernel_table const &table, bool const &)
+    {
+        return table.minimum;
+    }
+
+    static float combine(float x, float y)
+    {
+        return (y < x) ? y : x;
+    }
+
+    template<typename T>
+    static T finish(T const &x)
+    {
+        return x;
+    }
+
+    static double accumulate(double const &x, double const &a, double const &)
+    {
+        return std::min(x, a);
+    }
+};
+
+struct operation_max
+{
+    static constexpr char const *name    = "Max";
+    static constexpr char const *key     = "max";
+    static constexpr operation_kind kind = OPERATION_REDUCTION;
+    static constexpr double flops        = 1;
+    static constexpr std::size_t inputs  = 1;
+    static constexpr bool summation      = false;
+    static constexpr double identity     = -std::numeric_limits<double>::infinity();
+
+    static simd_reduce_kernel kernel(simd_kernel_table const &table, bool const &)
+    {
+        return table.maximum;
+    }
+
+    static float combine(float x, float y)
+    {
+        return (y > x) ? y : x;
+    }
+
+    template<typename T>
+    static T finish(T const &x)
+    {
+        return x;
+    }
+
+    static double accumulate(double const &x, double const &a, double const &)
+    {
+        return std::max(x, a);
+    }
+};
+
+struct operation_dot
+{
+    static constexpr char const *name    = "Dot";
+    static constexpr char const *key     = "dot";
+    static constexpr operation_kind kind = OPERATION_REDUCTION;
+    static constexpr std::size_t inputs  = 2;
+    static constexpr bool summation      = true;
+    static constexpr double identity     = 0;
+
+    /* Multiply and add */
+    static constexpr double flops = 2;
+
+    static simd_reduce_kernel kernel(simd_kernel_table const &table, bool const &kahan)
+    {
+        return kahan ? table.dot_kahan : table.dot;
+    }
+
+    static float combine(float x, float y)
+    {
+        return x + y;
+    }
+
+    template<typename T>
+    static T finish(T const &x)
+    {
+        return x;
+    }
+
+    static double accumulate(double const &x, double const &a, double const &b)
+    {
+        return x + (a * b);
+    }
+};
+
+struct operation_l2norm
+{
+    static constexpr char const *name    = "L2 norm";
+    static constexpr char const *key     = "l2norm";
+    static constexpr operation_kind kind = OPERATION_REDUCTION;
+    static constexpr std::size_t inputs  = 1;
+    static constexpr bool summation      = true;
+    static constexpr double identity     = 0;
+
+    /* Multiply and add */
+    static constexpr double flops = 2;
+
+    static simd_reduce_kernel kernel(simd_kernel_table const &table, bool const &kahan)
+    {
+        return kahan ? table.sum_squares_kahan : table.sum_squares;
+    }
+
+    static float combine(float x, float y)
+    {
+        return x + y;
+    }
+
+    /* The kernels sum the squares */
+    template<typename T>
+    static T finish(T const &x)
+    {
+        return std::sqrt(x);
+    }
+
+    static double accumulate(double const &x, double const &a, double const &)
+    {
+        return x + (a * a);
+    }
+};
+
+/* Every operation in the order compute_cpu runs them */
+typedef std::tuple<
+    operation_addition,
+    operation_remove,
+    operation_multiple,
+    operation_divide,
+    operation_exponentiation,
+    operation_log,
+    operation_sum,
+    operation_min,
+    operation_max,
+    operation_dot,
+    operation_l2norm>
+    operation_registry;
+
+/* Calls function(operation()) for every operation of the registry */
+template<typename function_type>
+void for_each_operation(function_type const &function)
+{
+    std::apply(
+        [&](auto... operations)
+        {
+            (function(operations), ...);
+        },
+        operation_registry());
+}
+
+/* Vectors read and written per element */
+template<typename operation>
+constexpr std::size_t get_operation_streams()
+{
+    if constexpr(operation::kind == OPERATION_BINARY)
+        return 3;
+    else if constexpr(operation::kind == OPERATION_UNARY)
+        return 2;
+    else
+        return operation::inputs;
+}
+
+/* Command line names of every operation */
+inline std::vector<std::string> get_operation_keys()
+{
+    std::vector<std::string> keys;
+
+    for_each_operation(
+        [&](auto operation)
+        {
+            keys.push_back(decltype(operation)::key);
+        });
+
+    return keys;
+}
+
+/* The same, comma separated */
+inline std::string get_operation_key_list()
+{
+    std::string list;
+
+    for(std::string const &key : get_operation_keys())
+    {
+        list += (list.empty() ? "" : ", ") + key;
+    }
+
+    return list;
+}
+
+/* Is the operation with the key among the selected ones (--operations), every operation is selected when none are */
+inline bool is_operation_selected(std::vector<std::string> const &operations, std::string const &key)
+{
+    return operations.empty() || (std::find(operations.begin(), operations.end(), key) != operations.end());
+}
+
+#endif // COMPUTE_OPERATIONS_H
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Roofline model of measured peaks
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/roofline.h"
+
+#include "io/log/logger.h"
+
+#include <algorithm>
+
+roofline::roofline(std::string const &device, double const &peak_bandwidth, double const &peak_flops)
+{
+    this->device         = device;
+    this->peak_bandwidth = peak_bandwidth;
+    this->peak_flops     = peak_flops;
+}
+
+double roofline::get_peak_bandwidth() const
+{
+    return peak_bandwidth;
+}
+
+double roofline::get_peak_flops() const
+{
+    return peak_flops;
+}
+
+void roofline::print_peaks() const
+{
+    spdlog::info("Peak bandwidth on {}: {:.2f} (GB/s)", device, peak_bandwidth / 1e9);
+    spdlog::info("Peak FLOP rate on {}: {:.2f} (GFLOP/s)", device, peak_flops / 1e9);
+
+    if(peak_bandwidth > 0)
+    {
+        spdlog::info("Ridge point on {}: {:.3f} (FLOP/byte)", device, peak_flops / peak_bandwidth);
+    }
+}
+
+void roofline::report(double const &bytes, double const &flops, double const &seconds) const
+{
+    if((seconds <= 0) || (bytes <= 0))
+    {
+        return;
+    }
+
+    if(flops <= 0)
+    {
+        if(peak_bandwidth > 0)
+        {
+            spdlog::info("Roofline on {}: {:.2f} (GB/s), {:.1f}% of peak bandwidth", device, bytes / seconds / 1e9, 100.0 * bytes / seconds / peak_bandwidth);
+        }
+
+        return;
+    }
+
+    double intensity  = flops / bytes;
+    double achieved   = flops / seconds;
+    double attainable = std::min(peak_flops, intensity * peak_bandwidth);
+
+    spdlog::info("Roofline on {}: {:.3e} (bytes), {:.3e} (FLOP), arithmetic intensity {:.3f} (FLOP/byte)", device, bytes, flops, intensity);
+
+    if(attainable <= 0)
+    {
+        spdlog::info("Roofline on {}: {:.2f} (GB/s), {:.2f} (GFLOP/s), peaks are not measured", device, bytes / seconds / 1e9, achieved / 1e9);
+        return;
+    }
+
+    spdlog::info(
+        "Roofline on {}: {:.2f} (GB/s), {:.2f} (GFLOP/s), {:.1f}% of roofline ({} bound, attainable {:.2f} GFLOP/s)",
+        device,
+        bytes / seconds / 1e9,
+        achieved / 1e9,
+        100.0 * achieved / attainable,
+        (intensity * peak_bandwidth < peak_flops) ? "memory" : "compute",
+        attainable / 1e9);
+}
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Roofline model of measured peaks
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_ROOFLINE_H
+#define COMPUTE_ROOFLINE_H
+
+#include <string>
+
+/*
+    Attainable FLOP/s of a kernel is min(peak FLOP/s, arithmetic intensity * peak bandwidth),
+    where arithmetic intensity is FLOPs per byte moved to and from memory.
+    Both peaks are measured on the device (see compute_cpu and compute_gpu).
+*/
+class roofline
+{
+public:
+    roofline() = default;
+    roofline(std::string const &device, double const &peak_bandwidth, double const &peak_flops);
+
+    /* FLOPs per element of the natural logarithm (range reduction and polynomial, see simd_log.h) */
+    static constexpr double log_flops = 20;
+
+    /* Bytes/s */
+    double get_peak_bandwidth() const;
+
+    /* FLOP/s */
+    double get_peak_flops() const;
+
+    /* Print the peaks and the ridge point (the intensity where a kernel stops being memory bound) */
+    void print_peaks() const;
+
+    /*
+        Print achieved GB/s, GFLOP/s and the percentage of roofline of a run, bytes are moved to and from memory
+        Without floating point operations (integer elements) only the bandwidth roof is printed
+    */
+    void report(double const &bytes, double const &flops, double const &seconds) const;
+
+private:
+    std::string device    = "unknown";
+    double peak_bandwidth = 0;
+    double peak_flops     = 0;
+};
+
+#endif // COMPUTE_ROOFLINE_H
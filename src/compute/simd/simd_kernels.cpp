@@ -0,0 +1,504 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Runtime dispatched SIMD kernels for the CPU elementwise operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/simd/simd_kernels.h"
+
+#include "compute/half_types.h"
+#include "compute/simd/simd_log.h"
+#include "platform/cpu_info.h"
+#include "platform/platform.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    void scalar_addition(float const *a, float const *b, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = a[i] + b[i];
+        }
+    }
+
+    void scalar_remove(float const *a, float const *b, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = a[i] - b[i];
+        }
+    }
+
+    void scalar_multiple(float const *a, float const *b, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = a[i] * b[i];
+        }
+    }
+
+    void scalar_divide(float const *a, float const *b, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = a[i] / b[i];
+        }
+    }
+
+    void scalar_exponentiation(float const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = a[i] * a[i];
+        }
+    }
+
+    void scalar_log(float const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = std::log(a[i]);
+        }
+    }
+
+    /* x = 2^exponent * (1 + f), returns f (x must be positive and finite) */
+    float log_reduce(float x, int &exponent)
+    {
+        int bias = 0;
+        if(x < simd_log::min_normal)
+        {
+            x *= simd_log::subnormal_scale;
+            bias = simd_log::subnormal_bias;
+        }
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        exponent = static_cast<int>(bits >> 23) - 127 - bias;
+        bits     = (bits & 0x007FFFFF) | 0x3F800000;
+
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+
+        if(m >= simd_log::sqrt_2)
+        {
+            m *= 0.5f;
+            exponent++;
+        }
+
+        return m - 1.0f;
+    }
+
+    /* Returns true and sets result if x is not a positive finite number */
+    bool log_special(float x, float &result)
+    {
+        if(x == 0.0f)
+        {
+            result = -std::numeric_limits<float>::infinity();
+            return true;
+        }
+
+        if(!(x >= 0.0f))
+        {
+            result = std::numeric_limits<float>::quiet_NaN();
+            return true;
+        }
+
+        if(x == std::numeric_limits<float>::infinity())
+        {
+            result = x;
+            return true;
+        }
+
+        return false;
+    }
+
+    void scalar_log_fast(float const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if(log_special(a[i], c[i]))
+            {
+                continue;
+            }
+
+            int exponent;
+            float f = log_reduce(a[i], exponent);
+            float e = static_cast<float>(exponent);
+            float z = f * f;
+
+            float p = simd_log::p6;
+            p       = std::fma(p, f, simd_log::p5);
+            p       = std::fma(p, f, simd_log::p4);
+            p       = std::fma(p, f, simd_log::p3);
+            p       = std::fma(p, f, simd_log::p2);
+            p       = std::fma(p, f, simd_log::p1);
+            p       = std::fma(p, f, simd_log::p0);
+
+            float r = (f * z) * p;
+            r       = std::fma(e, simd_log::ln2_lo, r);
+            r       = std::fma(z, -0.5f, r);
+            r       = f + r;
+            r       = std::fma(e, simd_log::ln2_hi, r);
+
+            c[i] = r;
+        }
+    }
+
+    void scalar_log_accurate(float const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if(log_special(a[i], c[i]))
+            {
+                continue;
+            }
+
+            int exponent;
+            double f  = log_reduce(a[i], exponent);
+            double s  = f / (f + 2.0);
+            double s2 = s * s;
+
+            double p = simd_log::s11;
+            p        = p * s2 + simd_log::s9;
+            p        = p * s2 + simd_log::s7;
+            p        = p * s2 + simd_log::s5;
+            p        = p * s2 + simd_log::s3;
+            p        = p * s2 + 1.0;
+
+            c[i] = static_cast<float>(exponent * simd_log::ln2 + (s + s) * p);
+        }
+    }
+
+    /* Independent chains hide the latency of the multiply and the add */
+    constexpr std::size_t flops_chains = 10;
+
+    volatile float flops_sink;
+
+    double scalar_flops(std::size_t iterations)
+    {
+        float m = 0.999999f;
+        float b = 1e-6f;
+        float acc[flops_chains];
+
+        for(std::size_t n = 0; n < flops_chains; n++)
+        {
+            acc[n] = 1.0f + static_cast<float>(n);
+        }
+
+        for(std::size_t i = 0; i < iterations; i++)
+        {
+            for(std::size_t n = 0; n < flops_chains; n++)
+            {
+                acc[n] = acc[n] * m + b;
+            }
+        }
+
+        float sum = acc[0];
+
+        for(std::size_t n = 1; n < flops_chains; n++)
+        {
+            sum += acc[n];
+        }
+
+        flops_sink = sum;
+
+        return 2.0 * flops_chains * static_cast<double>(iterations);
+    }
+
+    struct scalar_sum
+    {
+        static constexpr float identity = 0.0f;
+
+        static float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct scalar_minimum
+    {
+        static constexpr float identity = std::numeric_limits<float>::infinity();
+
+        static float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static float combine(float x, float y)
+        {
+            return (y < x) ? y : x;
+        }
+    };
+
+    struct scalar_maximum
+    {
+        static constexpr float identity = -std::numeric_limits<float>::infinity();
+
+        static float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static float combine(float x, float y)
+        {
+            return (y > x) ? y : x;
+        }
+    };
+
+    struct scalar_dot
+    {
+        static constexpr float identity = 0.0f;
+
+        static float value(float const *a, float const *b, std::size_t i)
+        {
+            return a[i] * b[i];
+        }
+
+        static float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct scalar_sum_squares
+    {
+        static constexpr float identity = 0.0f;
+
+        static float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i] * a[i];
+        }
+
+        static float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    template<typename op>
+    float scalar_reduce(float const *a, float const *b, std::size_t size)
+    {
+        float result = op::identity;
+
+        for(std::size_t i = 0; i < size; i++)
+        {
+            result = op::combine(result, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /* Kahan summation, compensation keeps the low order bits lost by every add */
+    template<typename op>
+    float scalar_reduce_kahan(float const *a, float const *b, std::size_t size)
+    {
+        float sum          = 0.0f;
+        float compensation = 0.0f;
+
+        for(std::size_t i = 0; i < size; i++)
+        {
+            float y      = op::value(a, b, i) - compensation;
+            float t      = sum + y;
+            compensation = (t - sum) - y;
+            sum          = t;
+        }
+
+        return sum;
+    }
+
+    void scalar_float16_to_float(std::uint16_t const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = float16_bits_to_float(a[i]);
+        }
+    }
+
+    void scalar_float_to_float16(float const *a, std::uint16_t *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = float_to_float16_bits(a[i]);
+        }
+    }
+
+    void scalar_bfloat16_to_float(std::uint16_t const *a, float *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = bfloat16_bits_to_float(a[i]);
+        }
+    }
+
+    void scalar_float_to_bfloat16(float const *a, std::uint16_t *c, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; i++)
+        {
+            c[i] = float_to_bfloat16_bits(a[i]);
+        }
+    }
+} // namespace
+
+void simd_kernels_scalar(simd_kernel_table &table)
+{
+    table.addition       = &scalar_addition;
+    table.remove         = &scalar_remove;
+    table.multiple       = &scalar_multiple;
+    table.divide         = &scalar_divide;
+    table.exponentiation = &scalar_exponentiation;
+    table.log            = &scalar_log;
+    table.log_accurate   = &scalar_log_accurate;
+    table.log_fast       = &scalar_log_fast;
+
+    table.addition_stream       = &scalar_addition;
+    table.remove_stream         = &scalar_remove;
+    table.multiple_stream       = &scalar_multiple;
+    table.divide_stream         = &scalar_divide;
+    table.exponentiation_stream = &scalar_exponentiation;
+    table.log_stream            = &scalar_log;
+    table.log_accurate_stream   = &scalar_log_accurate;
+    table.log_fast_stream       = &scalar_log_fast;
+
+    table.flops = &scalar_flops;
+
+    table.sum               = &scalar_reduce<scalar_sum>;
+    table.minimum           = &scalar_reduce<scalar_minimum>;
+    table.maximum           = &scalar_reduce<scalar_maximum>;
+    table.dot               = &scalar_reduce<scalar_dot>;
+    table.sum_squares       = &scalar_reduce<scalar_sum_squares>;
+    table.sum_kahan         = &scalar_reduce_kahan<scalar_sum>;
+    table.dot_kahan         = &scalar_reduce_kahan<scalar_dot>;
+    table.sum_squares_kahan = &scalar_reduce_kahan<scalar_sum_squares>;
+
+    table.float16_to_float  = &scalar_float16_to_float;
+    table.float_to_float16  = &scalar_float_to_float16;
+    table.bfloat16_to_float = &scalar_bfloat16_to_float;
+    table.float_to_bfloat16 = &scalar_float_to_bfloat16;
+}
+
+simd_kernels::simd_kernels()
+{
+    cpu_info &cpu_info_instance = cpu_info::instance();
+
+#ifdef NYX_SIMD_X86
+    if(cpu_info_instance.has_avx512f())
+        best = SIMD_AVX512;
+    else if(cpu_info_instance.has_avx2() && cpu_info_instance.has_fma() && cpu_info_instance.has_f16c())
+        best = SIMD_AVX2;
+    else if(cpu_info_instance.has_sse2())
+        best = SIMD_SSE2;
+#endif
+
+    set_isa(best);
+}
+
+simd_isa simd_kernels::get_isa() const
+{
+    return isa;
+}
+
+simd_isa simd_kernels::get_best_isa() const
+{
+    return best;
+}
+
+bool simd_kernels::is_supported(simd_isa const &isa) const
+{
+    return isa <= best;
+}
+
+void simd_kernels::set_isa(simd_isa const &isa)
+{
+    if(!is_supported(isa))
+    {
+        throw std::runtime_error("Instruction set " + get_isa_name(isa) + " is not supported on this machine.");
+    }
+
+    simd_kernel_table t;
+    simd_kernels_scalar(t);
+
+    switch(isa)
+    {
+#ifdef NYX_SIMD_X86
+        case SIMD_SSE2:
+            simd_kernels_sse2(t);
+            break;
+        case SIMD_AVX2:
+            simd_kernels_avx2(t);
+            break;
+        case SIMD_AVX512:
+            simd_kernels_avx512(t);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    this->table = t;
+    this->isa   = isa;
+}
+
+std::string simd_kernels::get_isa_name(simd_isa const &isa)
+{
+    switch(isa)
+    {
+        case SIMD_SCALAR:
+            return "Scalar";
+        case SIMD_SSE2:
+            return "SSE2";
+        case SIMD_AVX2:
+            return "AVX2";
+        case SIMD_AVX512:
+            return "AVX-512";
+        default:
+            return "UNKNOWN_ISA";
+    }
+}
+
+simd_isa simd_kernels::parse_isa(std::string const &name) const
+{
+    if(name == "auto")
+        return best;
+    if(name == "scalar")
+        return SIMD_SCALAR;
+    if(name == "sse2")
+        return SIMD_SSE2;
+    if(name == "avx2")
+        return SIMD_AVX2;
+    if(name == "avx512")
+        return SIMD_AVX512;
+
+    throw std::invalid_argument("Unknown instruction set: " + name);
+}
@@ -0,0 +1,164 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Runtime dispatched SIMD kernels for the CPU elementwise operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_SIMD_SIMD_KERNELS_H
+#define COMPUTE_SIMD_SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Instruction set used by the kernels */
+enum simd_isa
+{
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512
+};
+
+/* c[i] = a[i] op b[i] */
+typedef void (*simd_binary_kernel)(float const *a, float const *b, float *c, std::size_t size);
+
+/* c[i] = op(a[i]) */
+typedef void (*simd_unary_kernel)(float const *a, float *c, std::size_t size);
+
+/* Runs iterations of independent multiply-add chains, returns the count of floating point operations */
+typedef double (*simd_flops_kernel)(std::size_t iterations);
+
+/* Reduces a to one value, the dot product reduces a[i] * b[i] (b isn't read by the others and may be nullptr) */
+typedef float (*simd_reduce_kernel)(float const *a, float const *b, std::size_t size);
+
+/* c[i] = a[i], a holds half precision bits (see compute/half_types.h) */
+typedef void (*simd_to_float_kernel)(std::uint16_t const *a, float *c, std::size_t size);
+
+/* c[i] = a[i] rounded to nearest even half precision bits */
+typedef void (*simd_from_float_kernel)(float const *a, std::uint16_t *c, std::size_t size);
+
+struct simd_kernel_table
+{
+    simd_binary_kernel addition      = nullptr;
+    simd_binary_kernel remove        = nullptr;
+    simd_binary_kernel multiple      = nullptr;
+    simd_binary_kernel divide        = nullptr;
+    simd_unary_kernel exponentiation = nullptr;
+
+    /* Natural logarithm: std::log, at most 1 ULP and about 3 ULP (see simd_log.h) */
+    simd_unary_kernel log          = nullptr;
+    simd_unary_kernel log_accurate = nullptr;
+    simd_unary_kernel log_fast     = nullptr;
+
+    /*
+        The same kernels with non-temporal (streaming) stores of c, they don't
+        read c into the cache before writing it and don't evict a and b.
+        The scalar table uses the regular kernels
+    */
+    simd_binary_kernel addition_stream      = nullptr;
+    simd_binary_kernel remove_stream        = nullptr;
+    simd_binary_kernel multiple_stream      = nullptr;
+    simd_binary_kernel divide_stream        = nullptr;
+    simd_unary_kernel exponentiation_stream = nullptr;
+    simd_unary_kernel log_stream            = nullptr;
+    simd_unary_kernel log_accurate_stream   = nullptr;
+    simd_unary_kernel log_fast_stream       = nullptr;
+
+    /* Peak FLOP rate of one thread (see roofline) */
+    simd_flops_kernel flops = nullptr;
+
+    /*
+        Reductions with unrolled SIMD accumulators, the _kahan versions keep
+        a compensation term in every lane (Kahan summation)
+    */
+    simd_reduce_kernel sum               = nullptr;
+    simd_reduce_kernel minimum           = nullptr;
+    simd_reduce_kernel maximum           = nullptr;
+    simd_reduce_kernel dot               = nullptr;
+    simd_reduce_kernel sum_squares       = nullptr;
+    simd_reduce_kernel sum_kahan         = nullptr;
+    simd_reduce_kernel dot_kahan         = nullptr;
+    simd_reduce_kernel sum_squares_kahan = nullptr;
+
+    /* Conversions of IEEE binary16 (F16C on AVX2) and bfloat16 */
+    simd_to_float_kernel float16_to_float    = nullptr;
+    simd_from_float_kernel float_to_float16  = nullptr;
+    simd_to_float_kernel bfloat16_to_float   = nullptr;
+    simd_from_float_kernel float_to_bfloat16 = nullptr;
+};
+
+/*
+    Kernel tables of every instruction set
+    Each of them lives in its own translation unit (simd_kernels_<isa>.cpp)
+    that is compiled with the matching -m flags, so the rest of the
+    application is still built for the baseline architecture
+*/
+void simd_kernels_scalar(simd_kernel_table &table);
+void simd_kernels_sse2(simd_kernel_table &table);
+void simd_kernels_avx2(simd_kernel_table &table);
+void simd_kernels_avx512(simd_kernel_table &table);
+
+class simd_kernels
+{
+public:
+    /* Class */
+    static simd_kernels &instance()
+    {
+        static simd_kernels sk;
+        return sk;
+    }
+
+    /* Kernels of the selected instruction set */
+    simd_kernel_table const &get() const
+    {
+        return table;
+    }
+
+    simd_isa get_isa() const;
+    simd_isa get_best_isa() const;
+
+    /* Is the instruction set compiled in and supported by the processor */
+    bool is_supported(simd_isa const &isa) const;
+
+    /* Force the instruction set (throws std::runtime_error if it isn't supported) */
+    void set_isa(simd_isa const &isa);
+
+    static std::string get_isa_name(simd_isa const &isa);
+
+    /* "auto", "scalar", "sse2", "avx2" or "avx512" (throws std::invalid_argument) */
+    simd_isa parse_isa(std::string const &name) const;
+
+private:
+    /* Class */
+    simd_kernels();
+    simd_kernels(simd_kernels const &)            = delete;
+    simd_kernels &operator=(simd_kernels const &) = delete;
+
+    /* Variables */
+    simd_isa best = SIMD_SCALAR;
+    simd_isa isa  = SIMD_SCALAR;
+    simd_kernel_table table;
+};
+
+#endif // COMPUTE_SIMD_SIMD_KERNELS_H
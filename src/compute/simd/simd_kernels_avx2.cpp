@@ -0,0 +1,732 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief AVX2 kernels for the CPU elementwise operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+/*
+    This file is compiled with -mavx2 -mfma -mf16c, so it must not use inline functions
+    from other headers (they could be merged with the baseline copies by
+    the linker). Only intrinsics and local code.
+*/
+#include "compute/simd/simd_kernels.h"
+
+#include "compute/simd/simd_log.h"
+
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace
+{
+    struct op_addition
+    {
+        static inline __m256 apply(__m256 a, __m256 b)
+        {
+            return _mm256_add_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a + b;
+        }
+    };
+
+    struct op_remove
+    {
+        static inline __m256 apply(__m256 a, __m256 b)
+        {
+            return _mm256_sub_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a - b;
+        }
+    };
+
+    struct op_multiple
+    {
+        static inline __m256 apply(__m256 a, __m256 b)
+        {
+            return _mm256_mul_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a * b;
+        }
+    };
+
+    struct op_divide
+    {
+        static inline __m256 apply(__m256 a, __m256 b)
+        {
+            return _mm256_div_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a / b;
+        }
+    };
+
+    /* Regular stores, c stays in the cache */
+    struct store_regular
+    {
+        /* Elements written before the vector loop */
+        static inline std::size_t head(float const *, std::size_t)
+        {
+            return 0;
+        }
+
+        static inline void store(float *c, __m256 v)
+        {
+            _mm256_storeu_ps(c, v);
+        }
+
+        static inline void fence()
+        {
+        }
+    };
+
+    /* Non-temporal (streaming) stores, c is written around the cache */
+    struct store_stream
+    {
+        /* Elements before the first 32 byte aligned address of c, streaming stores need it */
+        static inline std::size_t head(float const *c, std::size_t size)
+        {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(c);
+
+            if((address % sizeof(float)) != 0)
+            {
+                return size;
+            }
+
+            std::size_t head = ((32 - (address % 32)) % 32) / sizeof(float);
+            return (head < size) ? head : size;
+        }
+
+        static inline void store(float *c, __m256 v)
+        {
+            _mm256_stream_ps(c, v);
+        }
+
+        /* Streaming stores are weakly ordered, make them visible before the threads are joined */
+        static inline void fence()
+        {
+            _mm_sfence();
+        }
+    };
+
+    template<typename op, typename store>
+    void binary(float const *a, float const *b, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t head = store::head(c, size); i < head; i++)
+        {
+            c[i] = op::apply(a[i], b[i]);
+        }
+
+        for(; i + 8 <= size; i += 8)
+        {
+            store::store(c + i, op::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+
+        for(; i < size; i++)
+        {
+            c[i] = op::apply(a[i], b[i]);
+        }
+
+        store::fence();
+    }
+
+    template<typename store>
+    void exponentiation(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t head = store::head(c, size); i < head; i++)
+        {
+            c[i] = a[i] * a[i];
+        }
+
+        for(; i + 8 <= size; i += 8)
+        {
+            __m256 va = _mm256_loadu_ps(a + i);
+            store::store(c + i, _mm256_mul_ps(va, va));
+        }
+
+        for(; i < size; i++)
+        {
+            c[i] = a[i] * a[i];
+        }
+
+        store::fence();
+    }
+
+    /* x = 2^exponent * (1 + f), returns f */
+    inline __m256 log_reduce(__m256 x, __m256i &exponent)
+    {
+        __m256 is_subnormal = _mm256_cmp_ps(x, _mm256_set1_ps(simd_log::min_normal), _CMP_LT_OQ);
+        x                   = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(simd_log::subnormal_scale)), is_subnormal);
+
+        __m256i bits = _mm256_castps_si256(x);
+        exponent     = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+        exponent     = _mm256_sub_epi32(exponent, _mm256_and_si256(_mm256_castps_si256(is_subnormal), _mm256_set1_epi32(simd_log::subnormal_bias)));
+
+        __m256 m        = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+        __m256 is_large = _mm256_cmp_ps(m, _mm256_set1_ps(simd_log::sqrt_2), _CMP_GE_OQ);
+        m               = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), is_large);
+
+        /* The mask is -1 in the selected lanes */
+        exponent = _mm256_sub_epi32(exponent, _mm256_castps_si256(is_large));
+
+        return _mm256_sub_ps(m, _mm256_set1_ps(1.0f));
+    }
+
+    inline __m256 log_special(__m256 x, __m256 result)
+    {
+        result = _mm256_blendv_ps(result, _mm256_set1_ps(-__builtin_inff()), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ));
+        result = _mm256_blendv_ps(result, _mm256_set1_ps(__builtin_nanf("")), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_NGE_UQ));
+        result = _mm256_blendv_ps(result, x, _mm256_cmp_ps(x, _mm256_set1_ps(__builtin_inff()), _CMP_EQ_OQ));
+        return result;
+    }
+
+    inline __m256 log_fast(__m256 x)
+    {
+        __m256i exponent;
+        __m256 f = log_reduce(x, exponent);
+        __m256 e = _mm256_cvtepi32_ps(exponent);
+        __m256 z = _mm256_mul_ps(f, f);
+
+        __m256 p = _mm256_set1_ps(simd_log::p6);
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p5));
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p4));
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p3));
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p2));
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p1));
+        p        = _mm256_fmadd_ps(p, f, _mm256_set1_ps(simd_log::p0));
+
+        __m256 r = _mm256_mul_ps(_mm256_mul_ps(f, z), p);
+        r        = _mm256_fmadd_ps(e, _mm256_set1_ps(simd_log::ln2_lo), r);
+        r        = _mm256_fmadd_ps(z, _mm256_set1_ps(-0.5f), r);
+        r        = _mm256_add_ps(f, r);
+        r        = _mm256_fmadd_ps(e, _mm256_set1_ps(simd_log::ln2_hi), r);
+
+        return log_special(x, r);
+    }
+
+    inline __m256d log_accurate_pd(__m256d f, __m256d e)
+    {
+        __m256d s  = _mm256_div_pd(f, _mm256_add_pd(f, _mm256_set1_pd(2.0)));
+        __m256d s2 = _mm256_mul_pd(s, s);
+
+        __m256d p = _mm256_set1_pd(simd_log::s11);
+        p         = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(simd_log::s9));
+        p         = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(simd_log::s7));
+        p         = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(simd_log::s5));
+        p         = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(simd_log::s3));
+        p         = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0));
+
+        return _mm256_fmadd_pd(e, _mm256_set1_pd(simd_log::ln2), _mm256_mul_pd(_mm256_add_pd(s, s), p));
+    }
+
+    inline __m256 log_accurate(__m256 x)
+    {
+        __m256i exponent;
+        __m256 f = log_reduce(x, exponent);
+
+        __m128 low  = _mm256_cvtpd_ps(log_accurate_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(f)), _mm256_cvtepi32_pd(_mm256_castsi256_si128(exponent))));
+        __m128 high = _mm256_cvtpd_ps(log_accurate_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)), _mm256_cvtepi32_pd(_mm256_extracti128_si256(exponent, 1))));
+
+        return log_special(x, _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1));
+    }
+
+    /*
+        Less than a vector of elements goes through the same vector code,
+        so results don't depend on the position
+    */
+    template<__m256 (*function)(__m256)>
+    void partial(float const *a, float *c, std::size_t count)
+    {
+        float buffer[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+        for(std::size_t n = 0; n < count; n++)
+        {
+            buffer[n] = a[n];
+        }
+
+        _mm256_storeu_ps(buffer, function(_mm256_loadu_ps(buffer)));
+
+        for(std::size_t n = 0; n < count; n++)
+        {
+            c[n] = buffer[n];
+        }
+    }
+
+    template<__m256 (*function)(__m256), typename store>
+    void unary(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = store::head(c, size);
+
+        if(i > 0)
+        {
+            partial<function>(a, c, i);
+        }
+
+        for(; i + 8 <= size; i += 8)
+        {
+            store::store(c + i, function(_mm256_loadu_ps(a + i)));
+        }
+
+        if(i < size)
+        {
+            partial<function>(a + i, c + i, size - i);
+        }
+
+        store::fence();
+    }
+
+    /* Independent chains hide the latency of FMA on both ports */
+    constexpr std::size_t flops_chains = 10;
+
+    volatile float flops_sink;
+
+    double flops(std::size_t iterations)
+    {
+        __m256 m = _mm256_set1_ps(0.999999f);
+        __m256 b = _mm256_set1_ps(1e-6f);
+        __m256 acc[flops_chains];
+
+        for(std::size_t n = 0; n < flops_chains; n++)
+        {
+            acc[n] = _mm256_set1_ps(1.0f + static_cast<float>(n));
+        }
+
+        for(std::size_t i = 0; i < iterations; i++)
+        {
+            for(std::size_t n = 0; n < flops_chains; n++)
+            {
+                acc[n] = _mm256_fmadd_ps(acc[n], m, b);
+            }
+        }
+
+        __m256 sum = acc[0];
+
+        for(std::size_t n = 1; n < flops_chains; n++)
+        {
+            sum = _mm256_add_ps(sum, acc[n]);
+        }
+
+        flops_sink = _mm256_cvtss_f32(sum);
+
+        return 2.0 * 8 * flops_chains * static_cast<double>(iterations);
+    }
+
+    constexpr std::size_t convert_width = 8;
+
+    inline void float16_to_float_step(std::uint16_t const *a, float *c)
+    {
+        _mm256_storeu_ps(c, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a))));
+    }
+
+    inline void float_to_float16_step(float const *a, std::uint16_t *c)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c), _mm256_cvtps_ph(_mm256_loadu_ps(a), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    inline void bfloat16_to_float_step(std::uint16_t const *a, float *c)
+    {
+        __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c), _mm256_slli_epi32(h, 16));
+    }
+
+    /* Rounds to nearest even, the bfloat16 bits are in the low half of every element, NaN is quieted */
+    inline __m256i round_bfloat16(__m256 x)
+    {
+        __m256i bits    = _mm256_castps_si256(x);
+        __m256i upper   = _mm256_srli_epi32(bits, 16);
+        __m256i odd     = _mm256_and_si256(upper, _mm256_set1_epi32(1));
+        __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF))), 16);
+        __m256i quiet   = _mm256_or_si256(upper, _mm256_set1_epi32(0x0040));
+        __m256i nan     = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+
+        return _mm256_blendv_epi8(rounded, quiet, nan);
+    }
+
+    inline void float_to_bfloat16_step(float const *a, std::uint16_t *c)
+    {
+        __m256i r = round_bfloat16(_mm256_loadu_ps(a));
+
+        /* packus works within 128 bit lanes, both packed halves are moved to the low lane */
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c), _mm256_castsi256_si128(packed));
+    }
+
+    /* Reductions, independent accumulators hide the latency of the adds */
+    constexpr std::size_t reduce_unroll = 4;
+
+    struct reduce_sum
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m256 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm256_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m256 combine(__m256 x, __m256 y)
+        {
+            return _mm256_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_minimum
+    {
+        static constexpr float identity = HUGE_VALF;
+
+        static inline __m256 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm256_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m256 combine(__m256 x, __m256 y)
+        {
+            return _mm256_min_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y < x) ? y : x;
+        }
+    };
+
+    struct reduce_maximum
+    {
+        static constexpr float identity = -HUGE_VALF;
+
+        static inline __m256 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm256_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m256 combine(__m256 x, __m256 y)
+        {
+            return _mm256_max_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y > x) ? y : x;
+        }
+    };
+
+    struct reduce_dot
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m256 load(float const *a, float const *b, std::size_t i)
+        {
+            return _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        }
+
+        static inline float value(float const *a, float const *b, std::size_t i)
+        {
+            return a[i] * b[i];
+        }
+
+        static inline __m256 combine(__m256 x, __m256 y)
+        {
+            return _mm256_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_sum_squares
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m256 load(float const *a, float const *, std::size_t i)
+        {
+            __m256 x = _mm256_loadu_ps(a + i);
+            return _mm256_mul_ps(x, x);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i] * a[i];
+        }
+
+        static inline __m256 combine(__m256 x, __m256 y)
+        {
+            return _mm256_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    template<typename op>
+    float reduce(float const *a, float const *b, std::size_t size)
+    {
+        __m256 acc[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            acc[n] = _mm256_set1_ps(op::identity);
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 8 * reduce_unroll <= size; i += 8 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                acc[n] = op::combine(acc[n], op::load(a, b, i + 8 * n));
+            }
+        }
+
+        for(; i + 8 <= size; i += 8)
+        {
+            acc[0] = op::combine(acc[0], op::load(a, b, i));
+        }
+
+        for(std::size_t n = 1; n < reduce_unroll; n++)
+        {
+            acc[0] = op::combine(acc[0], acc[n]);
+        }
+
+        float lanes[8];
+        _mm256_storeu_ps(lanes, acc[0]);
+
+        float result = lanes[0];
+
+        for(std::size_t n = 1; n < 8; n++)
+        {
+            result = op::combine(result, lanes[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            result = op::combine(result, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /* sum += value, compensation keeps the low order bits lost by the add */
+    inline void kahan_add(float &sum, float &compensation, float value)
+    {
+        float y      = value - compensation;
+        float t      = sum + y;
+        compensation = (t - sum) - y;
+        sum          = t;
+    }
+
+    /* Kahan summation in every lane, the lanes and the tail are summed with the same compensation */
+    template<typename op>
+    float reduce_kahan(float const *a, float const *b, std::size_t size)
+    {
+        __m256 sum[reduce_unroll];
+        __m256 compensation[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            sum[n]          = _mm256_setzero_ps();
+            compensation[n] = _mm256_setzero_ps();
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 8 * reduce_unroll <= size; i += 8 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                __m256 y        = _mm256_sub_ps(op::load(a, b, i + 8 * n), compensation[n]);
+                __m256 t        = _mm256_add_ps(sum[n], y);
+                compensation[n] = _mm256_sub_ps(_mm256_sub_ps(t, sum[n]), y);
+                sum[n]          = t;
+            }
+        }
+
+        for(; i + 8 <= size; i += 8)
+        {
+            __m256 y        = _mm256_sub_ps(op::load(a, b, i), compensation[0]);
+            __m256 t        = _mm256_add_ps(sum[0], y);
+            compensation[0] = _mm256_sub_ps(_mm256_sub_ps(t, sum[0]), y);
+            sum[0]          = t;
+        }
+
+        float lanes[8 * reduce_unroll];
+        float compensations[8 * reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            _mm256_storeu_ps(lanes + 8 * n, sum[n]);
+            _mm256_storeu_ps(compensations + 8 * n, compensation[n]);
+        }
+
+        float result              = 0.0f;
+        float result_compensation = 0.0f;
+
+        for(std::size_t n = 0; n < 8 * reduce_unroll; n++)
+        {
+            kahan_add(result, result_compensation, lanes[n]);
+            kahan_add(result, result_compensation, -compensations[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            kahan_add(result, result_compensation, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /*
+        Conversions between float and half precision bits, less than
+        convert_width elements go through the same vector code
+    */
+    template<void (*step)(std::uint16_t const *, float *)>
+    void to_float(std::uint16_t const *a, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            std::uint16_t buffer_a[convert_width] = {0};
+            float buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+
+    template<void (*step)(float const *, std::uint16_t *)>
+    void from_float(float const *a, std::uint16_t *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            float buffer_a[convert_width] = {0.0f};
+            std::uint16_t buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+} // namespace
+
+void simd_kernels_avx2(simd_kernel_table &table)
+{
+    table.addition       = &binary<op_addition, store_regular>;
+    table.remove         = &binary<op_remove, store_regular>;
+    table.multiple       = &binary<op_multiple, store_regular>;
+    table.divide         = &binary<op_divide, store_regular>;
+    table.exponentiation = &exponentiation<store_regular>;
+    table.log_fast       = &unary<log_fast, store_regular>;
+    table.log_accurate   = &unary<log_accurate, store_regular>;
+
+    table.addition_stream       = &binary<op_addition, store_stream>;
+    table.remove_stream         = &binary<op_remove, store_stream>;
+    table.multiple_stream       = &binary<op_multiple, store_stream>;
+    table.divide_stream         = &binary<op_divide, store_stream>;
+    table.exponentiation_stream = &exponentiation<store_stream>;
+    table.log_fast_stream       = &unary<log_fast, store_stream>;
+    table.log_accurate_stream   = &unary<log_accurate, store_stream>;
+
+    table.flops = &flops;
+
+    table.sum               = &reduce<reduce_sum>;
+    table.minimum           = &reduce<reduce_minimum>;
+    table.maximum           = &reduce<reduce_maximum>;
+    table.dot               = &reduce<reduce_dot>;
+    table.sum_squares       = &reduce<reduce_sum_squares>;
+    table.sum_kahan         = &reduce_kahan<reduce_sum>;
+    table.dot_kahan         = &reduce_kahan<reduce_dot>;
+    table.sum_squares_kahan = &reduce_kahan<reduce_sum_squares>;
+
+    table.float16_to_float  = &to_float<float16_to_float_step>;
+    table.float_to_float16  = &from_float<float_to_float16_step>;
+    table.bfloat16_to_float = &to_float<bfloat16_to_float_step>;
+    table.float_to_bfloat16 = &from_float<float_to_bfloat16_step>;
+}
@@ -0,0 +1,702 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief AVX-512 kernels for the CPU elementwise operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+/*
+    This file is compiled with -mavx512f, so it must not use inline functions
+    from other headers (they could be merged with the baseline copies by
+    the linker). Only intrinsics and local code.
+*/
+#include "compute/simd/simd_kernels.h"
+
+#include "compute/simd/simd_log.h"
+
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace
+{
+    struct op_addition
+    {
+        static inline __m512 apply(__m512 a, __m512 b)
+        {
+            return _mm512_add_ps(a, b);
+        }
+    };
+
+    struct op_remove
+    {
+        static inline __m512 apply(__m512 a, __m512 b)
+        {
+            return _mm512_sub_ps(a, b);
+        }
+    };
+
+    struct op_multiple
+    {
+        static inline __m512 apply(__m512 a, __m512 b)
+        {
+            return _mm512_mul_ps(a, b);
+        }
+    };
+
+    struct op_divide
+    {
+        static inline __m512 apply(__m512 a, __m512 b)
+        {
+            return _mm512_div_ps(a, b);
+        }
+    };
+
+    /* Mask of the first count (less than 16) lanes */
+    inline __mmask16 first(std::size_t count)
+    {
+        return static_cast<__mmask16>((1u << count) - 1);
+    }
+
+    /* Regular stores, c stays in the cache */
+    struct store_regular
+    {
+        /* Elements written before the vector loop */
+        static inline std::size_t head(float const *, std::size_t)
+        {
+            return 0;
+        }
+
+        static inline void store(float *c, __m512 v)
+        {
+            _mm512_storeu_ps(c, v);
+        }
+
+        static inline void fence()
+        {
+        }
+    };
+
+    /* Non-temporal (streaming) stores, c is written around the cache */
+    struct store_stream
+    {
+        /* Elements before the first 64 byte aligned address of c, streaming stores need it */
+        static inline std::size_t head(float const *c, std::size_t size)
+        {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(c);
+
+            if((address % sizeof(float)) != 0)
+            {
+                return size;
+            }
+
+            std::size_t head = ((64 - (address % 64)) % 64) / sizeof(float);
+            return (head < size) ? head : size;
+        }
+
+        static inline void store(float *c, __m512 v)
+        {
+            _mm512_stream_ps(c, v);
+        }
+
+        /* Streaming stores are weakly ordered, make them visible before the threads are joined */
+        static inline void fence()
+        {
+            _mm_sfence();
+        }
+    };
+
+    template<typename op, typename store>
+    void binary(float const *a, float const *b, float *c, std::size_t size)
+    {
+        std::size_t i = store::head(c, size);
+
+        if(i > 0)
+        {
+            __mmask16 mask = first(i);
+            _mm512_mask_storeu_ps(c, mask, op::apply(_mm512_maskz_loadu_ps(mask, a), _mm512_maskz_loadu_ps(mask, b)));
+        }
+
+        for(; i + 16 <= size; i += 16)
+        {
+            store::store(c + i, op::apply(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+
+        if(i < size)
+        {
+            __mmask16 mask = first(size - i);
+            _mm512_mask_storeu_ps(c + i, mask, op::apply(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+        }
+
+        store::fence();
+    }
+
+    template<typename store>
+    void exponentiation(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = store::head(c, size);
+
+        if(i > 0)
+        {
+            __mmask16 mask = first(i);
+            __m512 va      = _mm512_maskz_loadu_ps(mask, a);
+            _mm512_mask_storeu_ps(c, mask, _mm512_mul_ps(va, va));
+        }
+
+        for(; i + 16 <= size; i += 16)
+        {
+            __m512 va = _mm512_loadu_ps(a + i);
+            store::store(c + i, _mm512_mul_ps(va, va));
+        }
+
+        if(i < size)
+        {
+            __mmask16 mask = first(size - i);
+            __m512 va      = _mm512_maskz_loadu_ps(mask, a + i);
+            _mm512_mask_storeu_ps(c + i, mask, _mm512_mul_ps(va, va));
+        }
+
+        store::fence();
+    }
+
+    /* x = 2^exponent * (1 + f), returns f */
+    inline __m512 log_reduce(__m512 x, __m512i &exponent)
+    {
+        __mmask16 is_subnormal = _mm512_cmp_ps_mask(x, _mm512_set1_ps(simd_log::min_normal), _CMP_LT_OQ);
+        x                      = _mm512_mask_mul_ps(x, is_subnormal, x, _mm512_set1_ps(simd_log::subnormal_scale));
+
+        __m512i bits = _mm512_castps_si512(x);
+        exponent     = _mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(127));
+        exponent     = _mm512_mask_sub_epi32(exponent, is_subnormal, exponent, _mm512_set1_epi32(simd_log::subnormal_bias));
+
+        __m512 m           = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x007FFFFF)), _mm512_set1_epi32(0x3F800000)));
+        __mmask16 is_large = _mm512_cmp_ps_mask(m, _mm512_set1_ps(simd_log::sqrt_2), _CMP_GE_OQ);
+        m                  = _mm512_mask_mul_ps(m, is_large, m, _mm512_set1_ps(0.5f));
+        exponent           = _mm512_mask_add_epi32(exponent, is_large, exponent, _mm512_set1_epi32(1));
+
+        return _mm512_sub_ps(m, _mm512_set1_ps(1.0f));
+    }
+
+    inline __m512 log_special(__m512 x, __m512 result)
+    {
+        result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_EQ_OQ), result, _mm512_set1_ps(-__builtin_inff()));
+        result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_NGE_UQ), result, _mm512_set1_ps(__builtin_nanf("")));
+        result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_set1_ps(__builtin_inff()), _CMP_EQ_OQ), result, x);
+        return result;
+    }
+
+    inline __m512 log_fast(__m512 x)
+    {
+        __m512i exponent;
+        __m512 f = log_reduce(x, exponent);
+        __m512 e = _mm512_cvtepi32_ps(exponent);
+        __m512 z = _mm512_mul_ps(f, f);
+
+        __m512 p = _mm512_set1_ps(simd_log::p6);
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p5));
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p4));
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p3));
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p2));
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p1));
+        p        = _mm512_fmadd_ps(p, f, _mm512_set1_ps(simd_log::p0));
+
+        __m512 r = _mm512_mul_ps(_mm512_mul_ps(f, z), p);
+        r        = _mm512_fmadd_ps(e, _mm512_set1_ps(simd_log::ln2_lo), r);
+        r        = _mm512_fmadd_ps(z, _mm512_set1_ps(-0.5f), r);
+        r        = _mm512_add_ps(f, r);
+        r        = _mm512_fmadd_ps(e, _mm512_set1_ps(simd_log::ln2_hi), r);
+
+        return log_special(x, r);
+    }
+
+    inline __m512d log_accurate_pd(__m512d f, __m512d e)
+    {
+        __m512d s  = _mm512_div_pd(f, _mm512_add_pd(f, _mm512_set1_pd(2.0)));
+        __m512d s2 = _mm512_mul_pd(s, s);
+
+        __m512d p = _mm512_set1_pd(simd_log::s11);
+        p         = _mm512_fmadd_pd(p, s2, _mm512_set1_pd(simd_log::s9));
+        p         = _mm512_fmadd_pd(p, s2, _mm512_set1_pd(simd_log::s7));
+        p         = _mm512_fmadd_pd(p, s2, _mm512_set1_pd(simd_log::s5));
+        p         = _mm512_fmadd_pd(p, s2, _mm512_set1_pd(simd_log::s3));
+        p         = _mm512_fmadd_pd(p, s2, _mm512_set1_pd(1.0));
+
+        return _mm512_fmadd_pd(e, _mm512_set1_pd(simd_log::ln2), _mm512_mul_pd(_mm512_add_pd(s, s), p));
+    }
+
+    inline __m512 log_accurate(__m512 x)
+    {
+        __m512i exponent;
+        __m512 f = log_reduce(x, exponent);
+
+        __m256 f_low  = _mm512_castps512_ps256(f);
+        __m256 f_high = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(f), 1));
+
+        __m256 low  = _mm512_cvtpd_ps(log_accurate_pd(_mm512_cvtps_pd(f_low), _mm512_cvtepi32_pd(_mm512_castsi512_si256(exponent))));
+        __m256 high = _mm512_cvtpd_ps(log_accurate_pd(_mm512_cvtps_pd(f_high), _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(exponent, 1))));
+
+        __m512d result = _mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(low)), _mm256_castps_pd(high), 1);
+
+        return log_special(x, _mm512_castpd_ps(result));
+    }
+
+    template<__m512 (*function)(__m512), typename store>
+    void unary(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = store::head(c, size);
+
+        if(i > 0)
+        {
+            __mmask16 mask = first(i);
+            _mm512_mask_storeu_ps(c, mask, function(_mm512_maskz_loadu_ps(mask, a)));
+        }
+
+        for(; i + 16 <= size; i += 16)
+        {
+            store::store(c + i, function(_mm512_loadu_ps(a + i)));
+        }
+
+        if(i < size)
+        {
+            __mmask16 mask = first(size - i);
+            _mm512_mask_storeu_ps(c + i, mask, function(_mm512_maskz_loadu_ps(mask, a + i)));
+        }
+
+        store::fence();
+    }
+
+    /* Independent chains hide the latency of FMA on both ports */
+    constexpr std::size_t flops_chains = 10;
+
+    volatile float flops_sink;
+
+    double flops(std::size_t iterations)
+    {
+        __m512 m = _mm512_set1_ps(0.999999f);
+        __m512 b = _mm512_set1_ps(1e-6f);
+        __m512 acc[flops_chains];
+
+        for(std::size_t n = 0; n < flops_chains; n++)
+        {
+            acc[n] = _mm512_set1_ps(1.0f + static_cast<float>(n));
+        }
+
+        for(std::size_t i = 0; i < iterations; i++)
+        {
+            for(std::size_t n = 0; n < flops_chains; n++)
+            {
+                acc[n] = _mm512_fmadd_ps(acc[n], m, b);
+            }
+        }
+
+        __m512 sum = acc[0];
+
+        for(std::size_t n = 1; n < flops_chains; n++)
+        {
+            sum = _mm512_add_ps(sum, acc[n]);
+        }
+
+        flops_sink = _mm512_cvtss_f32(sum);
+
+        return 2.0 * 16 * flops_chains * static_cast<double>(iterations);
+    }
+
+    constexpr std::size_t convert_width = 16;
+
+    inline void float16_to_float_step(std::uint16_t const *a, float *c)
+    {
+        _mm512_storeu_ps(c, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(a))));
+    }
+
+    inline void float_to_float16_step(float const *a, std::uint16_t *c)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c), _mm512_cvtps_ph(_mm512_loadu_ps(a), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    inline void bfloat16_to_float_step(std::uint16_t const *a, float *c)
+    {
+        __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(a)));
+
+        _mm512_storeu_si512(c, _mm512_slli_epi32(h, 16));
+    }
+
+    /* Rounds to nearest even, the bfloat16 bits are in the low half of every element, NaN is quieted */
+    inline __m512i round_bfloat16(__m512 x)
+    {
+        __m512i bits    = _mm512_castps_si512(x);
+        __m512i upper   = _mm512_srli_epi32(bits, 16);
+        __m512i odd     = _mm512_and_si512(upper, _mm512_set1_epi32(1));
+        __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(odd, _mm512_set1_epi32(0x7FFF))), 16);
+        __m512i quiet   = _mm512_or_si512(upper, _mm512_set1_epi32(0x0040));
+        __mmask16 nan   = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+
+        return _mm512_mask_mov_epi32(rounded, nan, quiet);
+    }
+
+    inline void float_to_bfloat16_step(float const *a, std::uint16_t *c)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c), _mm512_cvtepi32_epi16(round_bfloat16(_mm512_loadu_ps(a))));
+    }
+
+    /* Reductions, independent accumulators hide the latency of the adds */
+    constexpr std::size_t reduce_unroll = 4;
+
+    struct reduce_sum
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m512 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm512_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m512 combine(__m512 x, __m512 y)
+        {
+            return _mm512_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_minimum
+    {
+        static constexpr float identity = HUGE_VALF;
+
+        static inline __m512 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm512_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m512 combine(__m512 x, __m512 y)
+        {
+            return _mm512_min_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y < x) ? y : x;
+        }
+    };
+
+    struct reduce_maximum
+    {
+        static constexpr float identity = -HUGE_VALF;
+
+        static inline __m512 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm512_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m512 combine(__m512 x, __m512 y)
+        {
+            return _mm512_max_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y > x) ? y : x;
+        }
+    };
+
+    struct reduce_dot
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m512 load(float const *a, float const *b, std::size_t i)
+        {
+            return _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        }
+
+        static inline float value(float const *a, float const *b, std::size_t i)
+        {
+            return a[i] * b[i];
+        }
+
+        static inline __m512 combine(__m512 x, __m512 y)
+        {
+            return _mm512_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_sum_squares
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m512 load(float const *a, float const *, std::size_t i)
+        {
+            __m512 x = _mm512_loadu_ps(a + i);
+            return _mm512_mul_ps(x, x);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i] * a[i];
+        }
+
+        static inline __m512 combine(__m512 x, __m512 y)
+        {
+            return _mm512_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    template<typename op>
+    float reduce(float const *a, float const *b, std::size_t size)
+    {
+        __m512 acc[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            acc[n] = _mm512_set1_ps(op::identity);
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 16 * reduce_unroll <= size; i += 16 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                acc[n] = op::combine(acc[n], op::load(a, b, i + 16 * n));
+            }
+        }
+
+        for(; i + 16 <= size; i += 16)
+        {
+            acc[0] = op::combine(acc[0], op::load(a, b, i));
+        }
+
+        for(std::size_t n = 1; n < reduce_unroll; n++)
+        {
+            acc[0] = op::combine(acc[0], acc[n]);
+        }
+
+        float lanes[16];
+        _mm512_storeu_ps(lanes, acc[0]);
+
+        float result = lanes[0];
+
+        for(std::size_t n = 1; n < 16; n++)
+        {
+            result = op::combine(result, lanes[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            result = op::combine(result, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /* sum += value, compensation keeps the low order bits lost by the add */
+    inline void kahan_add(float &sum, float &compensation, float value)
+    {
+        float y      = value - compensation;
+        float t      = sum + y;
+        compensation = (t - sum) - y;
+        sum          = t;
+    }
+
+    /* Kahan summation in every lane, the lanes and the tail are summed with the same compensation */
+    template<typename op>
+    float reduce_kahan(float const *a, float const *b, std::size_t size)
+    {
+        __m512 sum[reduce_unroll];
+        __m512 compensation[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            sum[n]          = _mm512_setzero_ps();
+            compensation[n] = _mm512_setzero_ps();
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 16 * reduce_unroll <= size; i += 16 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                __m512 y        = _mm512_sub_ps(op::load(a, b, i + 16 * n), compensation[n]);
+                __m512 t        = _mm512_add_ps(sum[n], y);
+                compensation[n] = _mm512_sub_ps(_mm512_sub_ps(t, sum[n]), y);
+                sum[n]          = t;
+            }
+        }
+
+        for(; i + 16 <= size; i += 16)
+        {
+            __m512 y        = _mm512_sub_ps(op::load(a, b, i), compensation[0]);
+            __m512 t        = _mm512_add_ps(sum[0], y);
+            compensation[0] = _mm512_sub_ps(_mm512_sub_ps(t, sum[0]), y);
+            sum[0]          = t;
+        }
+
+        float lanes[16 * reduce_unroll];
+        float compensations[16 * reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            _mm512_storeu_ps(lanes + 16 * n, sum[n]);
+            _mm512_storeu_ps(compensations + 16 * n, compensation[n]);
+        }
+
+        float result              = 0.0f;
+        float result_compensation = 0.0f;
+
+        for(std::size_t n = 0; n < 16 * reduce_unroll; n++)
+        {
+            kahan_add(result, result_compensation, lanes[n]);
+            kahan_add(result, result_compensation, -compensations[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            kahan_add(result, result_compensation, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /*
+        Conversions between float and half precision bits, less than
+        convert_width elements go through the same vector code
+    */
+    template<void (*step)(std::uint16_t const *, float *)>
+    void to_float(std::uint16_t const *a, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            std::uint16_t buffer_a[convert_width] = {0};
+            float buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+
+    template<void (*step)(float const *, std::uint16_t *)>
+    void from_float(float const *a, std::uint16_t *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            float buffer_a[convert_width] = {0.0f};
+            std::uint16_t buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+} // namespace
+
+void simd_kernels_avx512(simd_kernel_table &table)
+{
+    table.addition       = &binary<op_addition, store_regular>;
+    table.remove         = &binary<op_remove, store_regular>;
+    table.multiple       = &binary<op_multiple, store_regular>;
+    table.divide         = &binary<op_divide, store_regular>;
+    table.exponentiation = &exponentiation<store_regular>;
+    table.log_fast       = &unary<log_fast, store_regular>;
+    table.log_accurate   = &unary<log_accurate, store_regular>;
+
+    table.addition_stream       = &binary<op_addition, store_stream>;
+    table.remove_stream         = &binary<op_remove, store_stream>;
+    table.multiple_stream       = &binary<op_multiple, store_stream>;
+    table.divide_stream         = &binary<op_divide, store_stream>;
+    table.exponentiation_stream = &exponentiation<store_stream>;
+    table.log_fast_stream       = &unary<log_fast, store_stream>;
+    table.log_accurate_stream   = &unary<log_accurate, store_stream>;
+
+    table.flops = &flops;
+
+    table.sum               = &reduce<reduce_sum>;
+    table.minimum           = &reduce<reduce_minimum>;
+    table.maximum           = &reduce<reduce_maximum>;
+    table.dot               = &reduce<reduce_dot>;
+    table.sum_squares       = &reduce<reduce_sum_squares>;
+    table.sum_kahan         = &reduce_kahan<reduce_sum>;
+    table.dot_kahan         = &reduce_kahan<reduce_dot>;
+    table.sum_squares_kahan = &reduce_kahan<reduce_sum_squares>;
+
+    table.float16_to_float  = &to_float<float16_to_float_step>;
+    table.float_to_float16  = &from_float<float_to_float16_step>;
+    table.bfloat16_to_float = &to_float<bfloat16_to_float_step>;
+    table.float_to_bfloat16 = &from_float<float_to_bfloat16_step>;
+}
@@ -0,0 +1,728 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief SSE2 kernels for the CPU elementwise operations
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+/*
+    This file is compiled with -msse2, so it must not use inline functions
+    from other headers (they could be merged with the baseline copies by
+    the linker). Only intrinsics and local code.
+*/
+#include "compute/simd/simd_kernels.h"
+
+#include "compute/simd/simd_log.h"
+
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace
+{
+    struct op_addition
+    {
+        static inline __m128 apply(__m128 a, __m128 b)
+        {
+            return _mm_add_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a + b;
+        }
+    };
+
+    struct op_remove
+    {
+        static inline __m128 apply(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a - b;
+        }
+    };
+
+    struct op_multiple
+    {
+        static inline __m128 apply(__m128 a, __m128 b)
+        {
+            return _mm_mul_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a * b;
+        }
+    };
+
+    struct op_divide
+    {
+        static inline __m128 apply(__m128 a, __m128 b)
+        {
+            return _mm_div_ps(a, b);
+        }
+
+        static inline float apply(float a, float b)
+        {
+            return a / b;
+        }
+    };
+
+    /* Regular stores, c stays in the cache */
+    struct store_regular
+    {
+        /* Elements written before the vector loop */
+        static inline std::size_t head(float const *, std::size_t)
+        {
+            return 0;
+        }
+
+        static inline void store(float *c, __m128 v)
+        {
+            _mm_storeu_ps(c, v);
+        }
+
+        static inline void fence()
+        {
+        }
+    };
+
+    /* Non-temporal (streaming) stores, c is written around the cache */
+    struct store_stream
+    {
+        /* Elements before the first 16 byte aligned address of c, streaming stores need it */
+        static inline std::size_t head(float const *c, std::size_t size)
+        {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(c);
+
+            if((address % sizeof(float)) != 0)
+            {
+                return size;
+            }
+
+            std::size_t head = ((16 - (address % 16)) % 16) / sizeof(float);
+            return (head < size) ? head : size;
+        }
+
+        static inline void store(float *c, __m128 v)
+        {
+            _mm_stream_ps(c, v);
+        }
+
+        /* Streaming stores are weakly ordered, make them visible before the threads are joined */
+        static inline void fence()
+        {
+            _mm_sfence();
+        }
+    };
+
+    template<typename op, typename store>
+    void binary(float const *a, float const *b, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t head = store::head(c, size); i < head; i++)
+        {
+            c[i] = op::apply(a[i], b[i]);
+        }
+
+        for(; i + 4 <= size; i += 4)
+        {
+            store::store(c + i, op::apply(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+
+        for(; i < size; i++)
+        {
+            c[i] = op::apply(a[i], b[i]);
+        }
+
+        store::fence();
+    }
+
+    template<typename store>
+    void exponentiation(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t head = store::head(c, size); i < head; i++)
+        {
+            c[i] = a[i] * a[i];
+        }
+
+        for(; i + 4 <= size; i += 4)
+        {
+            __m128 va = _mm_loadu_ps(a + i);
+            store::store(c + i, _mm_mul_ps(va, va));
+        }
+
+        for(; i < size; i++)
+        {
+            c[i] = a[i] * a[i];
+        }
+
+        store::fence();
+    }
+
+    /* SSE2 has no blendv */
+    inline __m128 select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    /* x = 2^exponent * (1 + f), returns f */
+    inline __m128 log_reduce(__m128 x, __m128i &exponent)
+    {
+        __m128 is_subnormal = _mm_cmplt_ps(x, _mm_set1_ps(simd_log::min_normal));
+        x                   = select(is_subnormal, _mm_mul_ps(x, _mm_set1_ps(simd_log::subnormal_scale)), x);
+
+        __m128i bits = _mm_castps_si128(x);
+        exponent     = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+        exponent     = _mm_sub_epi32(exponent, _mm_and_si128(_mm_castps_si128(is_subnormal), _mm_set1_epi32(simd_log::subnormal_bias)));
+
+        __m128 m        = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+        __m128 is_large = _mm_cmpge_ps(m, _mm_set1_ps(simd_log::sqrt_2));
+        m               = select(is_large, _mm_mul_ps(m, _mm_set1_ps(0.5f)), m);
+
+        /* The mask is -1 in the selected lanes */
+        exponent = _mm_sub_epi32(exponent, _mm_castps_si128(is_large));
+
+        return _mm_sub_ps(m, _mm_set1_ps(1.0f));
+    }
+
+    inline __m128 log_special(__m128 x, __m128 result)
+    {
+        result = select(_mm_cmpeq_ps(x, _mm_setzero_ps()), _mm_set1_ps(-__builtin_inff()), result);
+        result = select(_mm_cmpnge_ps(x, _mm_setzero_ps()), _mm_set1_ps(__builtin_nanf("")), result);
+        result = select(_mm_cmpeq_ps(x, _mm_set1_ps(__builtin_inff())), x, result);
+        return result;
+    }
+
+    inline __m128 log_fast(__m128 x)
+    {
+        __m128i exponent;
+        __m128 f = log_reduce(x, exponent);
+        __m128 e = _mm_cvtepi32_ps(exponent);
+        __m128 z = _mm_mul_ps(f, f);
+
+        __m128 p = _mm_set1_ps(simd_log::p6);
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p5));
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p4));
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p3));
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p2));
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p1));
+        p        = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(simd_log::p0));
+
+        __m128 r = _mm_mul_ps(_mm_mul_ps(f, z), p);
+        r        = _mm_add_ps(_mm_mul_ps(e, _mm_set1_ps(simd_log::ln2_lo)), r);
+        r        = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(-0.5f)), r);
+        r        = _mm_add_ps(f, r);
+        r        = _mm_add_ps(_mm_mul_ps(e, _mm_set1_ps(simd_log::ln2_hi)), r);
+
+        return log_special(x, r);
+    }
+
+    inline __m128d log_accurate_pd(__m128d f, __m128d e)
+    {
+        __m128d s  = _mm_div_pd(f, _mm_add_pd(f, _mm_set1_pd(2.0)));
+        __m128d s2 = _mm_mul_pd(s, s);
+
+        __m128d p = _mm_set1_pd(simd_log::s11);
+        p         = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(simd_log::s9));
+        p         = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(simd_log::s7));
+        p         = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(simd_log::s5));
+        p         = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(simd_log::s3));
+        p         = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(1.0));
+
+        return _mm_add_pd(_mm_mul_pd(e, _mm_set1_pd(simd_log::ln2)), _mm_mul_pd(_mm_add_pd(s, s), p));
+    }
+
+    inline __m128 log_accurate(__m128 x)
+    {
+        __m128i exponent;
+        __m128 f = log_reduce(x, exponent);
+
+        __m128 low  = _mm_cvtpd_ps(log_accurate_pd(_mm_cvtps_pd(f), _mm_cvtepi32_pd(exponent)));
+        __m128 high = _mm_cvtpd_ps(log_accurate_pd(_mm_cvtps_pd(_mm_movehl_ps(f, f)), _mm_cvtepi32_pd(_mm_shuffle_epi32(exponent, _MM_SHUFFLE(3, 2, 3, 2)))));
+
+        return log_special(x, _mm_movelh_ps(low, high));
+    }
+
+    /*
+        Less than a vector of elements goes through the same vector code,
+        so results don't depend on the position
+    */
+    template<__m128 (*function)(__m128)>
+    void partial(float const *a, float *c, std::size_t count)
+    {
+        float buffer[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+        for(std::size_t n = 0; n < count; n++)
+        {
+            buffer[n] = a[n];
+        }
+
+        _mm_storeu_ps(buffer, function(_mm_loadu_ps(buffer)));
+
+        for(std::size_t n = 0; n < count; n++)
+        {
+            c[n] = buffer[n];
+        }
+    }
+
+    template<__m128 (*function)(__m128), typename store>
+    void unary(float const *a, float *c, std::size_t size)
+    {
+        std::size_t i = store::head(c, size);
+
+        if(i > 0)
+        {
+            partial<function>(a, c, i);
+        }
+
+        for(; i + 4 <= size; i += 4)
+        {
+            store::store(c + i, function(_mm_loadu_ps(a + i)));
+        }
+
+        if(i < size)
+        {
+            partial<function>(a + i, c + i, size - i);
+        }
+
+        store::fence();
+    }
+
+    /* Independent chains hide the latency of the multiply and the add (SSE2 has no FMA) */
+    constexpr std::size_t flops_chains = 10;
+
+    volatile float flops_sink;
+
+    double flops(std::size_t iterations)
+    {
+        __m128 m = _mm_set1_ps(0.999999f);
+        __m128 b = _mm_set1_ps(1e-6f);
+        __m128 acc[flops_chains];
+
+        for(std::size_t n = 0; n < flops_chains; n++)
+        {
+            acc[n] = _mm_set1_ps(1.0f + static_cast<float>(n));
+        }
+
+        for(std::size_t i = 0; i < iterations; i++)
+        {
+            for(std::size_t n = 0; n < flops_chains; n++)
+            {
+                acc[n] = _mm_add_ps(_mm_mul_ps(acc[n], m), b);
+            }
+        }
+
+        __m128 sum = acc[0];
+
+        for(std::size_t n = 1; n < flops_chains; n++)
+        {
+            sum = _mm_add_ps(sum, acc[n]);
+        }
+
+        flops_sink = _mm_cvtss_f32(sum);
+
+        return 2.0 * 4 * flops_chains * static_cast<double>(iterations);
+    }
+
+    /* bfloat16 is the upper half of a float, binary16 conversions need F16C (the scalar ones are used) */
+    constexpr std::size_t convert_width = 8;
+
+    inline void bfloat16_to_float_step(std::uint16_t const *a, float *c)
+    {
+        __m128i h    = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a));
+        __m128i zero = _mm_setzero_si128();
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c), _mm_unpacklo_epi16(zero, h));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c + 4), _mm_unpackhi_epi16(zero, h));
+    }
+
+    /* Rounds to nearest even, the bfloat16 bits are in the low half of every element, NaN is quieted */
+    inline __m128i round_bfloat16(__m128 x)
+    {
+        __m128i bits    = _mm_castps_si128(x);
+        __m128i upper   = _mm_srli_epi32(bits, 16);
+        __m128i odd     = _mm_and_si128(upper, _mm_set1_epi32(1));
+        __m128i rounded = _mm_srli_epi32(_mm_add_epi32(bits, _mm_add_epi32(odd, _mm_set1_epi32(0x7FFF))), 16);
+        __m128i quiet   = _mm_or_si128(upper, _mm_set1_epi32(0x0040));
+        __m128i nan     = _mm_castps_si128(_mm_cmpunord_ps(x, x));
+
+        return _mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded));
+    }
+
+    inline void float_to_bfloat16_step(float const *a, std::uint16_t *c)
+    {
+        /* packs saturates signed values, so the 16 bit results are sign extended first */
+        __m128i low  = _mm_srai_epi32(_mm_slli_epi32(round_bfloat16(_mm_loadu_ps(a)), 16), 16);
+        __m128i high = _mm_srai_epi32(_mm_slli_epi32(round_bfloat16(_mm_loadu_ps(a + 4)), 16), 16);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(c), _mm_packs_epi32(low, high));
+    }
+
+    /* Reductions, independent accumulators hide the latency of the adds */
+    constexpr std::size_t reduce_unroll = 4;
+
+    struct reduce_sum
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m128 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m128 combine(__m128 x, __m128 y)
+        {
+            return _mm_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_minimum
+    {
+        static constexpr float identity = HUGE_VALF;
+
+        static inline __m128 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m128 combine(__m128 x, __m128 y)
+        {
+            return _mm_min_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y < x) ? y : x;
+        }
+    };
+
+    struct reduce_maximum
+    {
+        static constexpr float identity = -HUGE_VALF;
+
+        static inline __m128 load(float const *a, float const *, std::size_t i)
+        {
+            return _mm_loadu_ps(a + i);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i];
+        }
+
+        static inline __m128 combine(__m128 x, __m128 y)
+        {
+            return _mm_max_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return (y > x) ? y : x;
+        }
+    };
+
+    struct reduce_dot
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m128 load(float const *a, float const *b, std::size_t i)
+        {
+            return _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        }
+
+        static inline float value(float const *a, float const *b, std::size_t i)
+        {
+            return a[i] * b[i];
+        }
+
+        static inline __m128 combine(__m128 x, __m128 y)
+        {
+            return _mm_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    struct reduce_sum_squares
+    {
+        static constexpr float identity = 0.0f;
+
+        static inline __m128 load(float const *a, float const *, std::size_t i)
+        {
+            __m128 x = _mm_loadu_ps(a + i);
+            return _mm_mul_ps(x, x);
+        }
+
+        static inline float value(float const *a, float const *, std::size_t i)
+        {
+            return a[i] * a[i];
+        }
+
+        static inline __m128 combine(__m128 x, __m128 y)
+        {
+            return _mm_add_ps(x, y);
+        }
+
+        static inline float combine(float x, float y)
+        {
+            return x + y;
+        }
+    };
+
+    template<typename op>
+    float reduce(float const *a, float const *b, std::size_t size)
+    {
+        __m128 acc[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            acc[n] = _mm_set1_ps(op::identity);
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 4 * reduce_unroll <= size; i += 4 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                acc[n] = op::combine(acc[n], op::load(a, b, i + 4 * n));
+            }
+        }
+
+        for(; i + 4 <= size; i += 4)
+        {
+            acc[0] = op::combine(acc[0], op::load(a, b, i));
+        }
+
+        for(std::size_t n = 1; n < reduce_unroll; n++)
+        {
+            acc[0] = op::combine(acc[0], acc[n]);
+        }
+
+        float lanes[4];
+        _mm_storeu_ps(lanes, acc[0]);
+
+        float result = lanes[0];
+
+        for(std::size_t n = 1; n < 4; n++)
+        {
+            result = op::combine(result, lanes[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            result = op::combine(result, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /* sum += value, compensation keeps the low order bits lost by the add */
+    inline void kahan_add(float &sum, float &compensation, float value)
+    {
+        float y      = value - compensation;
+        float t      = sum + y;
+        compensation = (t - sum) - y;
+        sum          = t;
+    }
+
+    /* Kahan summation in every lane, the lanes and the tail are summed with the same compensation */
+    template<typename op>
+    float reduce_kahan(float const *a, float const *b, std::size_t size)
+    {
+        __m128 sum[reduce_unroll];
+        __m128 compensation[reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            sum[n]          = _mm_setzero_ps();
+            compensation[n] = _mm_setzero_ps();
+        }
+
+        std::size_t i = 0;
+
+        for(; i + 4 * reduce_unroll <= size; i += 4 * reduce_unroll)
+        {
+            for(std::size_t n = 0; n < reduce_unroll; n++)
+            {
+                __m128 y        = _mm_sub_ps(op::load(a, b, i + 4 * n), compensation[n]);
+                __m128 t        = _mm_add_ps(sum[n], y);
+                compensation[n] = _mm_sub_ps(_mm_sub_ps(t, sum[n]), y);
+                sum[n]          = t;
+            }
+        }
+
+        for(; i + 4 <= size; i += 4)
+        {
+            __m128 y        = _mm_sub_ps(op::load(a, b, i), compensation[0]);
+            __m128 t        = _mm_add_ps(sum[0], y);
+            compensation[0] = _mm_sub_ps(_mm_sub_ps(t, sum[0]), y);
+            sum[0]          = t;
+        }
+
+        float lanes[4 * reduce_unroll];
+        float compensations[4 * reduce_unroll];
+
+        for(std::size_t n = 0; n < reduce_unroll; n++)
+        {
+            _mm_storeu_ps(lanes + 4 * n, sum[n]);
+            _mm_storeu_ps(compensations + 4 * n, compensation[n]);
+        }
+
+        float result              = 0.0f;
+        float result_compensation = 0.0f;
+
+        for(std::size_t n = 0; n < 4 * reduce_unroll; n++)
+        {
+            kahan_add(result, result_compensation, lanes[n]);
+            kahan_add(result, result_compensation, -compensations[n]);
+        }
+
+        for(; i < size; i++)
+        {
+            kahan_add(result, result_compensation, op::value(a, b, i));
+        }
+
+        return result;
+    }
+
+    /*
+        Conversions between float and half precision bits, less than
+        convert_width elements go through the same vector code
+    */
+    template<void (*step)(std::uint16_t const *, float *)>
+    void to_float(std::uint16_t const *a, float *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            std::uint16_t buffer_a[convert_width] = {0};
+            float buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+
+    template<void (*step)(float const *, std::uint16_t *)>
+    void from_float(float const *a, std::uint16_t *c, std::size_t size)
+    {
+        std::size_t i = 0;
+
+        for(; i + convert_width <= size; i += convert_width)
+        {
+            step(a + i, c + i);
+        }
+
+        if(i < size)
+        {
+            float buffer_a[convert_width] = {0.0f};
+            std::uint16_t buffer_c[convert_width];
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                buffer_a[n] = a[i + n];
+            }
+
+            step(buffer_a, buffer_c);
+
+            for(std::size_t n = 0; n < size - i; n++)
+            {
+                c[i + n] = buffer_c[n];
+            }
+        }
+    }
+} // namespace
+
+void simd_kernels_sse2(simd_kernel_table &table)
+{
+    table.addition       = &binary<op_addition, store_regular>;
+    table.remove         = &binary<op_remove, store_regular>;
+    table.multiple       = &binary<op_multiple, store_regular>;
+    table.divide         = &binary<op_divide, store_regular>;
+    table.exponentiation = &exponentiation<store_regular>;
+    table.log_fast       = &unary<log_fast, store_regular>;
+    table.log_accurate   = &unary<log_accurate, store_regular>;
+
+    table.addition_stream       = &binary<op_addition, store_stream>;
+    table.remove_stream         = &binary<op_remove, store_stream>;
+    table.multiple_stream       = &binary<op_multiple, store_stream>;
+    table.divide_stream         = &binary<op_divide, store_stream>;
+    table.exponentiation_stream = &exponentiation<store_stream>;
+    table.log_fast_stream       = &unary<log_fast, store_stream>;
+    table.log_accurate_stream   = &unary<log_accurate, store_stream>;
+
+    table.flops = &flops;
+
+    table.sum               = &reduce<reduce_sum>;
+    table.minimum           = &reduce<reduce_minimum>;
+    table.maximum           = &reduce<reduce_maximum>;
+    table.dot               = &reduce<reduce_dot>;
+    table.sum_squares       = &reduce<reduce_sum_squares>;
+    table.sum_kahan         = &reduce_kahan<reduce_sum>;
+    table.dot_kahan         = &reduce_kahan<reduce_dot>;
+    table.sum_squares_kahan = &reduce_kahan<reduce_sum_squares>;
+
+    table.bfloat16_to_float = &to_float<bfloat16_to_float_step>;
+    table.float_to_bfloat16 = &from_float<float_to_bfloat16_step>;
+}
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Constants of the vectorized natural logarithm
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_SIMD_SIMD_LOG_H
+#define COMPUTE_SIMD_SIMD_LOG_H
+
+/*
+    Both accuracy tiers share the argument reduction:
+        x = 2^e * m, sqrt(0.5) <= m < sqrt(2) (subnormals are scaled by 2^23 first)
+        f = m - 1 (exact)
+        log(x) = e * ln(2) + log(1 + f)
+
+    Fast tier (float arithmetic, within 3 ULP):
+        log(1 + f) = f - f^2 / 2 + f^3 * P(f)
+        P is a degree 6 minimax fit of the relative error on [sqrt(0.5) - 1, sqrt(2) - 1]
+        ln(2) is split into hi + lo parts so that e * ln2_hi is exact
+
+    Accurate tier (double arithmetic, at most 1 ULP):
+        s = f / (2 + f)
+        log(1 + f) = 2 * atanh(s) = 2s * (1 + s^2/3 + s^4/5 + ... + s^10/11)
+        |s| <= 0.1716, so the truncated series is accurate to ~5e-11 and the
+        result is rounded to float only once
+
+    Special values follow std::log: log(+-0) = -inf, log(x < 0) = NaN, log(+inf) = +inf, log(NaN) = NaN
+*/
+namespace simd_log
+{
+    /* Argument reduction */
+    constexpr float sqrt_2          = 1.41421356f;
+    constexpr float min_normal      = 1.17549435e-38f;
+    constexpr float subnormal_scale = 8388608.0f; /* 2^23 */
+    constexpr int subnormal_bias    = 23;
+
+    /* Fast tier */
+    constexpr float ln2_hi = 0.693359375f;
+    constexpr float ln2_lo = -2.12194440e-4f;
+    constexpr float p0     = 3.3333910739e-01f;
+    constexpr float p1     = -2.5001337036e-01f;
+    constexpr float p2     = 1.9963063698e-01f;
+    constexpr float p3     = -1.6577584768e-01f;
+    constexpr float p4     = 1.4914769222e-01f;
+    constexpr float p5     = -1.4267486216e-01f;
+    constexpr float p6     = 8.7004305716e-02f;
+
+    /* Accurate tier */
+    constexpr double ln2 = 0.69314718055994530942;
+    constexpr double s3  = 1.0 / 3.0;
+    constexpr double s5  = 1.0 / 5.0;
+    constexpr double s7  = 1.0 / 7.0;
+    constexpr double s9  = 1.0 / 9.0;
+    constexpr double s11 = 1.0 / 11.0;
+} // namespace simd_log
+
+#endif // COMPUTE_SIMD_SIMD_LOG_H
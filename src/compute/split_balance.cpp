@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Shares of a vector split between devices, the shards they run and the check of the result
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/split_balance.h"
+
+#include <algorithm>
+
+std::vector<double> get_rate_shares(std::vector<double> const &rates, double const &min_share)
+{
+    std::vector<double> shares(rates.size(), 1.0 / static_cast<double>(rates.size()));
+
+    double sum = 0;
+
+    for(double rate : rates)
+    {
+        sum += std::max(rate, 0.0);
+    }
+
+    if(sum <= 0)
+    {
+        return shares;
+    }
+
+    double total = 0;
+
+    for(std::size_t i = 0; i < rates.size(); i++)
+    {
+        shares[i]  = std::max(std::max(rates[i], 0.0) / sum, min_share);
+        total     += shares[i];
+    }
+
+    for(double &share : shares)
+    {
+        share /= total;
+    }
+
+    return shares;
+}
+
+std::vector<double> balance_shares(std::vector<double> const &shares, std::vector<double> const &rates, double const &min_share)
+{
+    if(std::any_of(rates.begin(), rates.end(), [](double rate) { return rate <= 0; }))
+    {
+        return shares;
+    }
+
+    /* All workers finish together when the shares follow the rates, half a step damps the noise of one iteration */
+    std::vector<double> target = get_rate_shares(rates, min_share);
+    std::vector<double> next(shares.size());
+
+    for(std::size_t i = 0; i < shares.size(); i++)
+    {
+        next[i] = 0.5 * (shares[i] + target[i]);
+    }
+
+    return next;
+}
+
+double get_shard_seconds(cl::Event &write_event, cl::Event &read_event)
+{
+    read_event.wait();
+
+    return static_cast<double>(read_event.getProfilingInfo<CL_PROFILING_COMMAND_END>() - write_event.getProfilingInfo<CL_PROFILING_COMMAND_START>()) / 1e9;
+}
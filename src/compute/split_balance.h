@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Shares of a vector split between devices, the shards they run and the check of the result
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_SPLIT_BALANCE_H
+#define COMPUTE_SPLIT_BALANCE_H
+
+// clang-format off
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_TARGET_OPENCL_VERSION  120
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+
+#if defined(__APPLE__) || defined(__MACOSX)
+	#include <OpenCL/cl.hpp>
+#else
+	#include <CL/cl.h>
+#endif
+// clang-format on
+
+#include "compute/operations.h"
+#include "core/huge_page_allocator.h"
+#include "io/log/logger.h"
+
+#include <CL/opencl.hpp>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+    A vector split between workers (the cpu and an OpenCL device in compute_gpu,
+    every OpenCL device in compute_multi_device) follows the elements per second
+    of every worker, so all of them finish at about the same time. The shares
+    are fractions of the vector that add up to 1
+*/
+
+/* Shares that follow the rates (elements per second), at least min_share before they are normalized (equal when nothing is measured) */
+std::vector<double> get_rate_shares(std::vector<double> const &rates, double const &min_share);
+
+/* Shares of the next iteration from the rates of the last one, a worker without a measurement (no elements or no time) keeps the shares */
+std::vector<double> balance_shares(std::vector<double> const &shares, std::vector<double> const &rates, double const &min_share);
+
+/* Device seconds of a shard, from the start of its first write to the end of its read back (waits for the read) */
+double get_shard_seconds(cl::Event &write_event, cl::Event &read_event);
+
+/* Arguments of the OpenCL kernel of the operation: a, b, c or a, c (unary operations don't read b) */
+template<typename operation>
+void set_shard_arguments(cl::Kernel &kernel, cl::Buffer &buffer_a, cl::Buffer &buffer_b, cl::Buffer &buffer_c);
+
+/*
+    Queue the elements [begin, end) of the operation on a device: the inputs are written to the buffers
+    from element begin - base, the float4 work items start there too and c is read back.
+    write_event is the first command, read_event the last, the queue is flushed so the device starts
+*/
+template<typename operation>
+void enqueue_shard(
+    cl::CommandQueue &queue,
+    cl::Kernel &kernel,
+    cl::NDRange const &local,
+    cl::Buffer &buffer_a,
+    cl::Buffer &buffer_b,
+    cl::Buffer &buffer_c,
+    huge_page_vector<float> const &vec_a,
+    huge_page_vector<float> const &vec_b,
+    huge_page_vector<float> &vec_c,
+    std::size_t const &begin,
+    std::size_t const &end,
+    std::size_t const &base,
+    cl::Event &write_event,
+    cl::Event &read_event);
+
+/* Print (with the label) how many elements of c differ from operation::apply */
+template<typename operation>
+void verify_split(std::string const &label, huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> const &vec_c);
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename operation>
+void set_shard_arguments(cl::Kernel &kernel, cl::Buffer &buffer_a, cl::Buffer &buffer_b, cl::Buffer &buffer_c)
+{
+    kernel.setArg(0, buffer_a);
+
+    if constexpr(operation::kind == OPERATION_BINARY)
+    {
+        kernel.setArg(1, buffer_b);
+        kernel.setArg(2, buffer_c);
+    }
+    else
+    {
+        kernel.setArg(1, buffer_c);
+    }
+}
+
+template<typename operation>
+void enqueue_shard(
+    cl::CommandQueue &queue,
+    cl::Kernel &kernel,
+    cl::NDRange const &local,
+    cl::Buffer &buffer_a,
+    cl::Buffer &buffer_b,
+    cl::Buffer &buffer_c,
+    huge_page_vector<float> const &vec_a,
+    huge_page_vector<float> const &vec_b,
+    huge_page_vector<float> &vec_c,
+    std::size_t const &begin,
+    std::size_t const &end,
+    std::size_t const &base,
+    cl::Event &write_event,
+    cl::Event &read_event)
+{
+    std::size_t offset = (begin - base) * sizeof(float);
+    std::size_t length = (end - begin) * sizeof(float);
+
+    queue.enqueueWriteBuffer(buffer_a, CL_FALSE, offset, length, &vec_a[begin], nullptr, &write_event);
+
+    if constexpr(operation::kind == OPERATION_BINARY)
+    {
+        queue.enqueueWriteBuffer(buffer_b, CL_FALSE, offset, length, &vec_b[begin]);
+    }
+
+    queue.enqueueNDRangeKernel(kernel, cl::NDRange((begin - base) / 4), cl::NDRange((end - begin) / 4), local);
+    queue.enqueueReadBuffer(buffer_c, CL_FALSE, offset, length, &vec_c[begin], nullptr, &read_event);
+    queue.flush();
+}
+
+template<typename operation>
+void verify_split(std::string const &label, huge_page_vector<float> const &vec_a, huge_page_vector<float> const &vec_b, huge_page_vector<float> const &vec_c)
+{
+    std::size_t mismatches = 0;
+
+    for(std::size_t i = 0; i < vec_c.size(); i++)
+    {
+        float expected;
+
+        if constexpr(operation::kind == OPERATION_BINARY)
+            expected = operation::apply(vec_a[i], vec_b[i]);
+        else
+            expected = operation::apply(vec_a[i]);
+
+        /* Devices and the vectorized cpu kernels may round differently (a few ULP) */
+        bool equal = (vec_c[i] == expected) || (std::isnan(vec_c[i]) && std::isnan(expected)) || (std::fabs(vec_c[i] - expected) <= 1e-5f * std::fabs(expected));
+
+        if(!equal)
+        {
+            mismatches++;
+        }
+    }
+
+    if(mismatches != 0)
+    {
+        spdlog::warn("{} result: {} of {} elements differ from the reference", label, mismatches, vec_c.size());
+    }
+    else
+    {
+        spdlog::info("{} result: matches the reference", label);
+    }
+}
+
+#endif // COMPUTE_SPLIT_BALANCE_H
@@ -0,0 +1,277 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Local work-group size autotuner with a tuning cache on disk
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "compute/work_group_tuner.h"
+
+#include "io/log/logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+work_group_tuner::work_group_tuner(cl::Device const &device, std::vector<std::string> const &sources, std::string const &cache_path, tune_mode const &mode)
+{
+    this->device     = device;
+    this->sources    = sources;
+    this->cache_path = cache_path;
+    this->mode       = mode;
+
+    if(mode == TUNE_MODE_OFF)
+    {
+        return;
+    }
+
+    device_name    = device.getInfo<CL_DEVICE_NAME>();
+    driver_version = device.getInfo<CL_DRIVER_VERSION>();
+
+    /* The strings of the OpenCL runtime may end with '\0' */
+    device_name.erase(std::find(device_name.begin(), device_name.end(), '\0'), device_name.end());
+    driver_version.erase(std::find(driver_version.begin(), driver_version.end(), '\0'), driver_version.end());
+
+    load();
+}
+
+cl::NDRange work_group_tuner::get_local(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &name, std::size_t const &global)
+{
+    if(mode == TUNE_MODE_OFF)
+    {
+        return cl::NullRange;
+    }
+
+    std::string key = get_key(name);
+
+    bool cached = (cache.find(key) != cache.end());
+    bool force  = (mode == TUNE_MODE_FORCE) && (swept.find(key) == swept.end());
+
+    if(!cached || force)
+    {
+        cache[key] = sweep(queue, kernel, name, global);
+        swept.insert(key);
+        save();
+    }
+
+    return find_local(name, global);
+}
+
+cl::NDRange work_group_tuner::find_local(std::string const &name, std::size_t const &global) const
+{
+    if(mode == TUNE_MODE_OFF)
+    {
+        return cl::NullRange;
+    }
+
+    auto it = cache.find(get_key(name));
+
+    /* OpenCL 1.2 needs the global size to be a multiple of the local size */
+    if((it == cache.end()) || (it->second == 0) || (global % it->second != 0))
+    {
+        return cl::NullRange;
+    }
+
+    return cl::NDRange(it->second);
+}
+
+std::string work_group_tuner::get_key(std::string const &name) const
+{
+    std::ostringstream key;
+    key << device_name << '\t' << driver_version << '\t' << name << '\t' << std::hex << get_kernel_hash(name);
+
+    return key.str();
+}
+
+std::uint64_t work_group_tuner::get_kernel_hash(std::string const &name) const
+{
+    std::string const definition = " " + name + "(";
+
+    auto it = std::find_if(sources.begin(), sources.end(), [&](std::string const &source) { return source.find(definition) != std::string::npos; });
+
+    std::uint64_t hash = 14695981039346656037ull;
+
+    auto hash_source = [&](std::string const &source)
+    {
+        for(unsigned char c : source)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    if(it != sources.end())
+    {
+        hash_source(*it);
+    }
+    else
+    {
+        std::for_each(sources.begin(), sources.end(), hash_source);
+    }
+
+    return hash;
+}
+
+std::size_t work_group_tuner::sweep(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &name, std::size_t const &global)
+{
+    std::size_t max_local = kernel.getWorkGroupInfo<CL_KERNEL_WORK_GROUP_SIZE>(device);
+    std::size_t multiple  = kernel.getWorkGroupInfo<CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE>(device);
+
+    std::vector<std::size_t> max_items = device.getInfo<CL_DEVICE_MAX_WORK_ITEM_SIZES>();
+
+    if(!max_items.empty())
+    {
+        max_local = std::min(max_local, max_items[0]);
+    }
+
+    multiple = std::max<std::size_t>(multiple, 1);
+
+    /* The runtime choice first, a size has to beat it */
+    std::vector<std::size_t> candidates = {0};
+
+    for(std::size_t local = multiple; local <= max_local; local *= 2)
+    {
+        if(global % local == 0)
+        {
+            candidates.push_back(local);
+        }
+    }
+
+    if((max_local > 0) && (global % max_local == 0) && (std::find(candidates.begin(), candidates.end(), max_local) == candidates.end()))
+    {
+        candidates.push_back(max_local);
+    }
+
+    std::size_t best_local  = 0;
+    double best_nanoseconds = std::numeric_limits<double>::max();
+    double null_nanoseconds = 0;
+
+    for(std::size_t local : candidates)
+    {
+        double nanoseconds = measure(queue, kernel, global, local);
+
+        spdlog::debug("Work-group size of {}: {} ({:.3f} microseconds)", name, (local == 0) ? std::string("runtime") : std::to_string(local), nanoseconds / 1e3);
+
+        if(local == 0)
+        {
+            null_nanoseconds = nanoseconds;
+        }
+
+        if(nanoseconds < best_nanoseconds)
+        {
+            best_local       = local;
+            best_nanoseconds = nanoseconds;
+        }
+    }
+
+    spdlog::info(
+        "Work-group size of {}: {} of {} sizes, {:.3f} (microseconds per launch), runtime choice {:.3f} (microseconds per launch)",
+        name,
+        (best_local == 0) ? std::string("runtime choice") : std::to_string(best_local),
+        candidates.size(),
+        best_nanoseconds / 1e3,
+        null_nanoseconds / 1e3);
+
+    return best_local;
+}
+
+double work_group_tuner::measure(cl::CommandQueue &queue, cl::Kernel &kernel, std::size_t const &global, std::size_t const &local)
+{
+    cl::NDRange local_range = (local == 0) ? cl::NullRange : cl::NDRange(local);
+
+    std::vector<cl::Event> events(sweep_runs);
+
+    for(std::size_t r = 0; r < sweep_runs; r++)
+    {
+        queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(global), local_range, nullptr, &events[r]);
+    }
+
+    queue.finish();
+
+    double best = std::numeric_limits<double>::max();
+
+    for(std::size_t r = 1; r < sweep_runs; r++)
+    {
+        best = std::min(best, static_cast<double>(events[r].getProfilingInfo<CL_PROFILING_COMMAND_END>() - events[r].getProfilingInfo<CL_PROFILING_COMMAND_START>()));
+    }
+
+    return best;
+}
+
+void work_group_tuner::load()
+{
+    std::ifstream file(cache_path);
+
+    if(!file.is_open())
+    {
+        spdlog::info("Work-group tuning cache {} not found, kernels are swept on first use", cache_path);
+        return;
+    }
+
+    std::string line;
+
+    while(std::getline(file, line))
+    {
+        if(line.empty() || (line[0] == '#'))
+        {
+            continue;
+        }
+
+        /* The local size is the last field, the rest is the key */
+        std::size_t tab = line.rfind('\t');
+
+        if(tab == std::string::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            cache[line.substr(0, tab)] = std::stoull(line.substr(tab + 1));
+        }
+        catch(std::exception const &)
+        {
+            spdlog::warn("Work-group tuning cache {}: skipped line {}", cache_path, line);
+        }
+    }
+
+    spdlog::info("Work-group tuning cache {}: {} kernels", cache_path, cache.size());
+}
+
+void work_group_tuner::save() const
+{
+    std::ofstream file(cache_path, std::ios::trunc);
+
+    if(!file.is_open())
+    {
+        spdlog::warn("Can't write work-group tuning cache {}", cache_path);
+        return;
+    }
+
+    file << "# device name, driver version, kernel name, kernel hash, local work-group size (0 - runtime choice)" << std::endl;
+
+    for(auto const &entry : cache)
+    {
+        file << entry.first << '\t' << entry.second << std::endl;
+    }
+}
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Local work-group size autotuner with a tuning cache on disk
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef COMPUTE_WORK_GROUP_TUNER_H
+#define COMPUTE_WORK_GROUP_TUNER_H
+
+// clang-format off
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_TARGET_OPENCL_VERSION  120
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+
+#if defined(__APPLE__) || defined(__MACOSX)
+	#include <OpenCL/cl.hpp>
+#else
+	#include <CL/cl.h>
+#endif
+// clang-format on
+
+#include "core/settings.h"
+
+#include <CL/opencl.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+    The local work-group size a kernel runs fastest with depends on the device,
+    its driver and the kernel itself. The tuner sweeps the legal sizes of a kernel
+    (multiples of CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE up to
+    CL_KERNEL_WORK_GROUP_SIZE and CL_DEVICE_MAX_WORK_ITEM_SIZES that divide the
+    global size, and the runtime choice) on the device, timing every size with
+    profiling events, and keeps the fastest one in a text file:
+        <device name> <driver version> <kernel name> <kernel hash> <local size>
+    one tab separated line per kernel, 0 is the runtime choice (cl::NullRange).
+    The kernel hash is FNV-1a of the source that defines the kernel, so an edited
+    kernel, another driver or another device are swept again
+*/
+class work_group_tuner
+{
+public:
+    work_group_tuner() = default;
+    work_group_tuner(cl::Device const &device, std::vector<std::string> const &sources, std::string const &cache_path, tune_mode const &mode);
+
+    /*
+        Local size for the kernel over global, its arguments must be set
+        The kernel is swept on queue first when the cache has no size for it (TUNE_MODE_AUTO)
+        or it was not swept in this run yet (TUNE_MODE_FORCE)
+    */
+    cl::NDRange get_local(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &name, std::size_t const &global);
+
+    /* Local size from the cache without a sweep, cl::NullRange when there is none or it doesn't divide global */
+    cl::NDRange find_local(std::string const &name, std::size_t const &global) const;
+
+private:
+    cl::Device device;
+    std::string device_name;
+    std::string driver_version;
+    std::vector<std::string> sources;
+    std::string cache_path;
+    tune_mode mode = TUNE_MODE_OFF;
+
+    /* Key (see get_key) and the local size, entries of other devices are kept and written back */
+    std::map<std::string, std::size_t> cache;
+
+    /* Kernels swept in this run */
+    std::set<std::string> swept;
+
+    /* Launches timed for every size, the first one only warms up */
+    static constexpr std::size_t sweep_runs = 6;
+
+    std::string get_key(std::string const &name) const;
+
+    /* FNV-1a of the source defining the kernel (of every source if none does) */
+    std::uint64_t get_kernel_hash(std::string const &name) const;
+
+    /* Local size with the shortest launch, 0 if the runtime choice is the fastest */
+    std::size_t sweep(cl::CommandQueue &queue, cl::Kernel &kernel, std::string const &name, std::size_t const &global);
+
+    /* Device time of the fastest launch of the sweep_runs, in nanoseconds */
+    double measure(cl::CommandQueue &queue, cl::Kernel &kernel, std::size_t const &global, std::size_t const &local);
+
+    void load();
+    void save() const;
+};
+
+#endif // COMPUTE_WORK_GROUP_TUNER_H
@@ -0,0 +1,203 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Huge page aligned allocator for benchmark vectors
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "core/huge_page_allocator.h"
+
+#include "core/parallel_for.h"
+#include "io/log/logger.h"
+#include "platform/cpu_topology.h"
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
+
+namespace
+{
+    std::size_t round_up(std::size_t const &bytes, std::size_t const &alignment)
+    {
+        return ((bytes + alignment - 1) / alignment) * alignment;
+    }
+
+    /* Regular pages and small allocations don't need mmap */
+    bool is_mapped(std::size_t const &bytes, page_mode const &mode)
+    {
+        return (mode != PAGE_MODE_DEFAULT) && (bytes >= huge_page_size);
+    }
+
+#ifdef __linux__
+    /* Reserved huge pages, nullptr if there are not enough of them (see /proc/sys/vm/nr_hugepages) */
+    void *map_hugetlb(std::size_t const &length)
+    {
+        static std::atomic<bool> warned(false);
+
+        void *pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if(pointer != MAP_FAILED)
+        {
+            return pointer;
+        }
+
+        if(!warned.exchange(true))
+        {
+            spdlog::warn("MAP_HUGETLB failed (no reserved huge pages?), using transparent huge pages");
+        }
+
+        return nullptr;
+    }
+
+    /* 2 MiB aligned mapping, the kernel is asked to back it with transparent huge pages */
+    void *map_transparent(std::size_t const &length)
+    {
+        /* Map a huge page more and unmap the unaligned head and tail */
+        void *raw = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if(raw == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        std::uintptr_t begin   = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t aligned = round_up(begin, huge_page_size);
+        std::uintptr_t end     = begin + length + huge_page_size;
+
+        if(aligned > begin)
+        {
+            munmap(raw, aligned - begin);
+        }
+
+        if(end > (aligned + length))
+        {
+            munmap(reinterpret_cast<void *>(aligned + length), end - (aligned + length));
+        }
+
+        /* Only a hint, THP may be disabled or limited to madvise regions (/sys/kernel/mm/transparent_hugepage/enabled) */
+        madvise(reinterpret_cast<void *>(aligned), length, MADV_HUGEPAGE);
+
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    /*
+        One part of whole huge pages per thread, split like parallel_for splits the
+        elements, with the node of the thread's CPU preferred for it. The pages stay
+        local even if another thread touches them first. Only for pinned threads
+        on more than one node, otherwise first touch places them (see fill_vectors)
+    */
+    void place_pages(void *pointer, std::size_t const &length)
+    {
+        cpu_topology &topology = cpu_topology::instance();
+
+        if(topology.get_node_count() < 2)
+        {
+            return;
+        }
+
+        std::vector<std::size_t> cpus = get_parallel_affinity_cpus();
+
+        if(cpus.empty())
+        {
+            return;
+        }
+
+        static std::atomic<bool> warned(false);
+
+        std::size_t threads = get_parallel_thread_count();
+        std::size_t pages   = length / huge_page_size;
+
+        for(std::size_t part = 0; part < threads; part++)
+        {
+            std::size_t first = (pages * part) / threads;
+            std::size_t last  = (pages * (part + 1)) / threads;
+
+            if(first == last)
+            {
+                continue;
+            }
+
+            char *begin      = static_cast<char *>(pointer) + (first * huge_page_size);
+            std::size_t node = topology.get_node(cpus[part % cpus.size()]);
+
+            if(!cpu_topology::bind_memory(begin, (last - first) * huge_page_size, node) && !warned.exchange(true))
+            {
+                spdlog::warn("mbind failed, pages are placed by first touch only");
+            }
+        }
+    }
+#endif
+} // namespace
+
+void *huge_page_allocate(std::size_t const &bytes, page_mode const &mode)
+{
+    if(!is_mapped(bytes, mode))
+    {
+        return ::operator new(bytes, std::align_val_t(huge_page_allocator_alignment));
+    }
+
+#ifdef __linux__
+    std::size_t length = round_up(bytes, huge_page_size);
+
+    if(mode == PAGE_MODE_HUGETLB)
+    {
+        void *pointer = map_hugetlb(length);
+
+        if(pointer != nullptr)
+        {
+            place_pages(pointer, length);
+            return pointer;
+        }
+    }
+
+    void *pointer = map_transparent(length);
+    place_pages(pointer, length);
+    return pointer;
+#else
+    /* Aligned to huge pages at least, the system decides about the page size */
+    return ::operator new(bytes, std::align_val_t(huge_page_size));
+#endif
+}
+
+void huge_page_deallocate(void *pointer, std::size_t const &bytes, page_mode const &mode)
+{
+    if(pointer == nullptr)
+    {
+        return;
+    }
+
+    if(!is_mapped(bytes, mode))
+    {
+        ::operator delete(pointer, std::align_val_t(huge_page_allocator_alignment));
+        return;
+    }
+
+#ifdef __linux__
+    /* Both kinds of mappings are whole huge pages long */
+    munmap(pointer, round_up(bytes, huge_page_size));
+#else
+    ::operator delete(pointer, std::align_val_t(huge_page_size));
+#endif
+}
@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Huge page aligned allocator for benchmark vectors
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef CORE_HUGE_PAGE_ALLOCATOR_H
+#define CORE_HUGE_PAGE_ALLOCATOR_H
+
+#include "core/settings.h"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Every allocation is aligned at least to a cache line (and a whole AVX-512 vector) */
+constexpr std::size_t huge_page_allocator_alignment = 64;
+
+/* Size of a huge page, allocations of at least this size are aligned to it */
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+/*
+    Raw memory of the given page mode (see page_mode)
+    Throws std::bad_alloc, memory must be freed with the same size and mode
+*/
+void *huge_page_allocate(std::size_t const &bytes, page_mode const &mode);
+void huge_page_deallocate(void *pointer, std::size_t const &bytes, page_mode const &mode);
+
+/*
+    Allocator for std::vector that backs large vectors with huge pages, so
+    a 400 MB vector needs 200 TLB entries instead of 102400. The page mode
+    is taken from settings when the allocator is created and is kept by
+    the copies, so memory is always freed the way it was allocated.
+
+    Elements are default initialized, so huge_page_vector<float>(size)
+    doesn't write the memory. The pages are touched first by the parallel
+    fill (see compute/fill_vectors.h), which places them on the NUMA node
+    of the thread that computes on them later. With pinned threads (see
+    affinity_policy) mapped vectors also get the nodes of the
+    threads as their preferred nodes (mbind) before they are touched.
+*/
+template<typename T>
+class huge_page_allocator
+{
+public:
+    typedef T value_type;
+
+    huge_page_allocator()
+        : mode(settings::instance().get_page_mode())
+    {
+    }
+
+    template<typename U>
+    huge_page_allocator(huge_page_allocator<U> const &other) noexcept
+        : mode(other.get_mode())
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if(n > (std::numeric_limits<std::size_t>::max() / sizeof(T)))
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T *>(huge_page_allocate(n * sizeof(T), mode));
+    }
+
+    void deallocate(T *pointer, std::size_t n) noexcept
+    {
+        huge_page_deallocate(pointer, n * sizeof(T), mode);
+    }
+
+    template<typename U>
+    void construct(U *pointer) noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        ::new(static_cast<void *>(pointer)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U *pointer, Args &&...args)
+    {
+        ::new(static_cast<void *>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    page_mode get_mode() const noexcept
+    {
+        return mode;
+    }
+
+private:
+    page_mode mode = PAGE_MODE_TRANSPARENT;
+};
+
+template<typename T, typename U>
+bool operator==(huge_page_allocator<T> const &a, huge_page_allocator<U> const &b) noexcept
+{
+    return a.get_mode() == b.get_mode();
+}
+
+template<typename T, typename U>
+bool operator!=(huge_page_allocator<T> const &a, huge_page_allocator<U> const &b) noexcept
+{
+    return !(a == b);
+}
+
+/* Vector of benchmark data */
+template<typename T>
+using huge_page_vector = std::vector<T, huge_page_allocator<T>>;
+
+#endif // CORE_HUGE_PAGE_ALLOCATOR_H
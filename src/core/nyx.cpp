@@ -37,9 +37,13 @@
 
 #include "compute/compute_cpu.h"
 #include "compute/compute_gpu.h"
+#include "compute/compute_multi_device.h"
+#include "compute/simd/simd_kernels.h"
+#include "core/parallel_for.h"
 #include "core/settings.h"
 #include "platform/platform.h"
 #include "io/log/logger.h"
+#include "platform/cpu_topology.h"
 #include "gui/cl_image.h"
 #include "gui/cl_mandelbrot.h"
 #include "gui/sdl_wrapper.h"
@@ -51,12 +55,14 @@
 #include "gui/rgb_cube.h"
 #include "gui/rgb_cube_texture.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <getopt.h>
 #include <iostream>
 #include <signal.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <vector>
 
 int main(int argc, char *argv[])
 {
@@ -85,17 +91,43 @@ int main(int argc, char *argv[])
     settings &settings_instance = settings::instance();
 
     /* Options */
-    std::string const short_opts = "gcv:i:t:bhu";
+    std::string const short_opts = "gcv:i:t:s:m:k:a:fn:p:l:e:r:x:y:o:zw:A:B:O:T:C:X:N:MD:Rbhu";
 
-    std::array<option, 8> long_options = {
+    std::array<option, 34> long_options = {
         {{"gpu", no_argument, nullptr, 'g'},
          {"cpu", no_argument, nullptr, 'c'},
          {"vector-size", required_argument, nullptr, 'v'},
          {"iteration-count", required_argument, nullptr, 'i'},
          {"task-number", required_argument, nullptr, 't'},
+         {"simd", required_argument, nullptr, 's'},
+         {"cpu-mode", required_argument, nullptr, 'm'},
+         {"chunk-size", required_argument, nullptr, 'k'},
+         {"log-accuracy", required_argument, nullptr, 'a'},
+         {"fusion", no_argument, nullptr, 'f'},
+         {"store-mode", required_argument, nullptr, 'n'},
+         {"parallel", required_argument, nullptr, 'p'},
+         {"pages", required_argument, nullptr, 'l'},
+         {"element-types", required_argument, nullptr, 'e'},
+         {"reduction", required_argument, nullptr, 'r'},
+         {"scaling", required_argument, nullptr, 'x'},
+         {"affinity", required_argument, nullptr, 'y'},
+         {"operations", required_argument, nullptr, 'o'},
+         {"split", no_argument, nullptr, 'z'},
+         {"stream", required_argument, nullptr, 'w'},
+         {"input-a", required_argument, nullptr, 'A'},
+         {"input-b", required_argument, nullptr, 'B'},
+         {"output", required_argument, nullptr, 'O'},
+         {"tune", required_argument, nullptr, 'T'},
+         {"tune-cache", required_argument, nullptr, 'C'},
+         {"transfer", required_argument, nullptr, 'X'},
+         {"pipeline-chunks", required_argument, nullptr, 'N'},
+         {"multi-device", no_argument, nullptr, 'M'},
+         {"sub-devices", required_argument, nullptr, 'D'},
+         {"transfer-bench", no_argument, nullptr, 'R'},
          {"verbose", no_argument, nullptr, 'b'},
          {"help", no_argument, nullptr, 'h'},
-         {"build-info", no_argument, nullptr, 'u'}}};
+         {"build-info", no_argument, nullptr, 'u'},
+         {nullptr, 0, nullptr, 0}}};
 
     while(true)
     {
@@ -227,6 +259,489 @@ int main(int argc, char *argv[])
 
                 break;
             }
+            case 's':
+            {
+                simd_kernels &simd_kernels_instance = simd_kernels::instance();
+                try
+                {
+                    simd_kernels_instance.set_isa(simd_kernels_instance.parse_isa(optarg));
+                }
+                catch(std::exception const &e)
+                {
+                    spdlog::error("unexpected -s or --simd argument: {}\n{}", optarg, e.what());
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("SIMD instruction set: {}", simd_kernels::get_isa_name(simd_kernels_instance.get_isa()));
+                break;
+            }
+            case 'm':
+            {
+                std::string m = optarg;
+
+                if(m == "legacy")
+                {
+                    settings_instance.set_cpu_mode(CPU_MODE_LEGACY);
+                }
+                else if(m == "chunked")
+                {
+                    settings_instance.set_cpu_mode(CPU_MODE_CHUNKED);
+                }
+                else if(m == "blocked")
+                {
+                    settings_instance.set_cpu_mode(CPU_MODE_BLOCKED);
+                }
+                else
+                {
+                    spdlog::error("argument -m or --cpu-mode must be legacy, chunked or blocked");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("CPU execution mode: {}", m);
+                break;
+            }
+            case 'k':
+            {
+                long long k = 0;
+                try
+                {
+                    k = std::stoll(optarg);
+                }
+                catch(std::invalid_argument const &e)
+                {
+                    spdlog::error("unexpected -k or --chunk-size argument: {}\n{}", optarg, e.what());
+                    exit(EXIT_FAILURE);
+                }
+                catch(...)
+                {
+                    spdlog::error("unexpected -k or --chunk-size argument: {}", optarg);
+                    exit(EXIT_FAILURE);
+                }
+
+                if(k <= 0)
+                {
+                    spdlog::error("argument -k or --chunk-size must be greater than zero");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Chunk size: {}", k);
+
+                settings_instance.set_chunk_size(k);
+                break;
+            }
+            case 'a':
+            {
+                std::string a = optarg;
+
+                if(a == "std")
+                {
+                    settings_instance.set_log_accuracy(LOG_ACCURACY_STD);
+                }
+                else if(a == "accurate")
+                {
+                    settings_instance.set_log_accuracy(LOG_ACCURACY_ACCURATE);
+                }
+                else if(a == "fast")
+                {
+                    settings_instance.set_log_accuracy(LOG_ACCURACY_FAST);
+                }
+                else
+                {
+                    spdlog::error("argument -a or --log-accuracy must be std, accurate or fast");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Log accuracy: {}", a);
+                break;
+            }
+            case 'f':
+                settings_instance.set_fusion(true);
+                spdlog::info("Perform cpu fusion tests");
+                break;
+            case 'n':
+            {
+                std::string n = optarg;
+
+                if(n == "regular")
+                {
+                    settings_instance.set_store_mode(STORE_MODE_REGULAR);
+                }
+                else if(n == "streaming")
+                {
+                    settings_instance.set_store_mode(STORE_MODE_STREAMING);
+                }
+                else if(n == "auto")
+                {
+                    settings_instance.set_store_mode(STORE_MODE_AUTO);
+                }
+                else
+                {
+                    spdlog::error("argument -n or --store-mode must be regular, streaming or auto");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Store mode: {}", n);
+                break;
+            }
+            case 'p':
+            {
+                std::string p = optarg;
+
+                if(p == "openmp")
+                {
+#ifdef _OPENMP
+                    settings_instance.set_parallel_backend(PARALLEL_BACKEND_OPENMP);
+#else
+                    spdlog::error("argument -p or --parallel: the application is built without OpenMP");
+                    exit(EXIT_FAILURE);
+#endif
+                }
+                else if(p == "pool")
+                {
+                    settings_instance.set_parallel_backend(PARALLEL_BACKEND_THREAD_POOL);
+                }
+                else
+                {
+                    spdlog::error("argument -p or --parallel must be openmp or pool");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Parallel backend: {}", p);
+                break;
+            }
+            case 'l':
+            {
+                std::string l = optarg;
+
+                if(l == "default")
+                {
+                    settings_instance.set_page_mode(PAGE_MODE_DEFAULT);
+                }
+                else if(l == "thp")
+                {
+                    settings_instance.set_page_mode(PAGE_MODE_TRANSPARENT);
+                }
+                else if(l == "hugetlb")
+                {
+                    settings_instance.set_page_mode(PAGE_MODE_HUGETLB);
+                }
+                else
+                {
+                    spdlog::error("argument -l or --pages must be default, thp or hugetlb");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Pages: {}", l);
+                break;
+            }
+            case 'e':
+            {
+                std::string e = optarg;
+                std::vector<element_type> element_types;
+
+                if(e == "all")
+                {
+                    element_types = {ELEMENT_FLOAT, ELEMENT_DOUBLE, ELEMENT_INT32, ELEMENT_UINT8, ELEMENT_FLOAT16, ELEMENT_BFLOAT16};
+                }
+                else
+                {
+                    /* Comma separated list */
+                    std::size_t begin = 0;
+
+                    while(begin <= e.size())
+                    {
+                        std::size_t end = e.find(',', begin);
+
+                        if(end == std::string::npos)
+                        {
+                            end = e.size();
+                        }
+
+                        std::string type = e.substr(begin, end - begin);
+
+                        if(type == "float")
+                        {
+                            element_types.push_back(ELEMENT_FLOAT);
+                        }
+                        else if(type == "double")
+                        {
+                            element_types.push_back(ELEMENT_DOUBLE);
+                        }
+                        else if(type == "int32")
+                        {
+                            element_types.push_back(ELEMENT_INT32);
+                        }
+                        else if(type == "uint8")
+                        {
+                            element_types.push_back(ELEMENT_UINT8);
+                        }
+                        else if(type == "fp16")
+                        {
+                            element_types.push_back(ELEMENT_FLOAT16);
+                        }
+                        else if(type == "bf16")
+                        {
+                            element_types.push_back(ELEMENT_BFLOAT16);
+                        }
+                        else
+                        {
+                            spdlog::error("argument -e or --element-types must be all or a comma separated list of float, double, int32, uint8, fp16 and bf16");
+                            exit(EXIT_FAILURE);
+                        }
+
+                        begin = end + 1;
+                    }
+                }
+
+                settings_instance.set_element_types(element_types);
+                spdlog::info("Element types: {}", e);
+                break;
+            }
+            case 'r':
+            {
+                std::string r = optarg;
+
+                if(r == "simple")
+                {
+                    settings_instance.set_reduction_mode(REDUCTION_MODE_SIMPLE);
+                }
+                else if(r == "pairwise")
+                {
+                    settings_instance.set_reduction_mode(REDUCTION_MODE_PAIRWISE);
+                }
+                else if(r == "kahan")
+                {
+                    settings_instance.set_reduction_mode(REDUCTION_MODE_KAHAN);
+                }
+                else
+                {
+                    spdlog::error("argument -r or --reduction must be simple, pairwise or kahan");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Reduction: {}", r);
+                break;
+            }
+            case 'x':
+                settings_instance.set_scaling_file(optarg);
+                spdlog::info("Perform cpu scaling tests, table: {}", optarg);
+                break;
+            case 'y':
+            {
+                std::string y = optarg;
+
+                if(y == "none")
+                {
+                    settings_instance.set_affinity(AFFINITY_NONE);
+                }
+                else if(y == "compact")
+                {
+                    settings_instance.set_affinity(AFFINITY_COMPACT);
+                }
+                else if(y == "scatter")
+                {
+                    settings_instance.set_affinity(AFFINITY_SCATTER);
+                }
+                else
+                {
+                    try
+                    {
+                        settings_instance.set_affinity_cpus(cpu_topology::parse_cpu_list(y));
+                        settings_instance.set_affinity(AFFINITY_EXPLICIT);
+                    }
+                    catch(std::invalid_argument const &)
+                    {
+                        spdlog::error("argument -y or --affinity must be none, compact, scatter or a cpu list (for example 0-3,8)");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+
+                spdlog::info("Affinity: {}", y);
+                break;
+            }
+            case 'o':
+            {
+                std::string o                 = optarg;
+                std::vector<std::string> keys = get_operation_keys();
+                std::vector<std::string> operations;
+
+                /* Comma separated list, "all" leaves it empty (every operation) */
+                std::size_t begin = 0;
+
+                while((o != "all") && (begin <= o.size()))
+                {
+                    std::size_t end = o.find(',', begin);
+
+                    if(end == std::string::npos)
+                    {
+                        end = o.size();
+                    }
+
+                    std::string key = o.substr(begin, end - begin);
+
+                    if(std::find(keys.begin(), keys.end(), key) == keys.end())
+                    {
+                        spdlog::error("argument -o or --operations must be all or a comma separated list of: {}", get_operation_key_list());
+                        exit(EXIT_FAILURE);
+                    }
+
+                    operations.push_back(key);
+
+                    begin = end + 1;
+                }
+
+                settings_instance.set_operations(operations);
+                spdlog::info("Operations: {}", o);
+                break;
+            }
+            case 'z':
+                settings_instance.set_split(true);
+                spdlog::info("Perform split cpu and gpu tests");
+                break;
+            case 'w':
+                settings_instance.set_stream_directory(optarg);
+                spdlog::info("Perform cpu stream tests, files: {}", optarg);
+                break;
+            case 'A':
+                settings_instance.set_input_a(optarg);
+                spdlog::info("Dataset a: {}", optarg);
+                break;
+            case 'B':
+                settings_instance.set_input_b(optarg);
+                spdlog::info("Dataset b: {}", optarg);
+                break;
+            case 'O':
+                settings_instance.set_output(optarg);
+                spdlog::info("Dataset output: {}", optarg);
+                break;
+            case 'T':
+            {
+                std::string t = optarg;
+
+                if(t == "off")
+                {
+                    settings_instance.set_tune_mode(TUNE_MODE_OFF);
+                }
+                else if(t == "auto")
+                {
+                    settings_instance.set_tune_mode(TUNE_MODE_AUTO);
+                }
+                else if(t == "force")
+                {
+                    settings_instance.set_tune_mode(TUNE_MODE_FORCE);
+                }
+                else
+                {
+                    spdlog::error("argument -T or --tune must be off, auto or force");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Work-group tuning: {}", t);
+                break;
+            }
+            case 'C':
+                settings_instance.set_tune_cache(optarg);
+                spdlog::info("Work-group tuning cache: {}", optarg);
+                break;
+            case 'X':
+            {
+                std::string x = optarg;
+
+                if(x == "copy")
+                {
+                    settings_instance.set_transfer_mode(TRANSFER_MODE_COPY);
+                }
+                else if(x == "host-pointer")
+                {
+                    settings_instance.set_transfer_mode(TRANSFER_MODE_HOST_POINTER);
+                }
+                else if(x == "host-allocated")
+                {
+                    settings_instance.set_transfer_mode(TRANSFER_MODE_HOST_ALLOCATED);
+                }
+                else if(x == "pipeline")
+                {
+                    settings_instance.set_transfer_mode(TRANSFER_MODE_PIPELINE);
+                }
+                else if(x == "all")
+                {
+                    settings_instance.set_transfer_mode(TRANSFER_MODE_ALL);
+                }
+                else
+                {
+                    spdlog::error("argument -X or --transfer must be copy, host-pointer, host-allocated, pipeline or all");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Transfer mode: {}", x);
+                break;
+            }
+            case 'N':
+            {
+                long long chunks = 0;
+                try
+                {
+                    chunks = std::stoll(optarg);
+                }
+                catch(std::invalid_argument const &e)
+                {
+                    spdlog::error("unexpected -N or --pipeline-chunks argument: {}\n{}", optarg, e.what());
+                    exit(EXIT_FAILURE);
+                }
+                catch(...)
+                {
+                    spdlog::error("unexpected -N or --pipeline-chunks argument: {}", optarg);
+                    exit(EXIT_FAILURE);
+                }
+
+                if(chunks <= 0)
+                {
+                    spdlog::error("argument -N or --pipeline-chunks must be greater than zero");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Pipeline chunks: {}", chunks);
+
+                settings_instance.set_pipeline_chunks(chunks);
+                break;
+            }
+            case 'M':
+                settings_instance.set_multi_device(true);
+                spdlog::info("Perform multi-device tests");
+                break;
+            case 'D':
+            {
+                long long count = 0;
+                try
+                {
+                    count = std::stoll(optarg);
+                }
+                catch(std::invalid_argument const &e)
+                {
+                    spdlog::error("unexpected -D or --sub-devices argument: {}\n{}", optarg, e.what());
+                    exit(EXIT_FAILURE);
+                }
+                catch(...)
+                {
+                    spdlog::error("unexpected -D or --sub-devices argument: {}", optarg);
+                    exit(EXIT_FAILURE);
+                }
+
+                if(count <= 0)
+                {
+                    spdlog::error("argument -D or --sub-devices must be greater than zero");
+                    exit(EXIT_FAILURE);
+                }
+
+                spdlog::info("Sub-devices: {}", count);
+
+                settings_instance.set_sub_devices(count);
+                break;
+            }
+            case 'R':
+                settings_instance.set_transfer_bench(true);
+                spdlog::info("Perform transfer benchmark");
+                break;
             case 'b':
                 settings_instance.set_verbose(true);
                 spdlog::info("Verbose output set");
@@ -246,17 +761,80 @@ int main(int argc, char *argv[])
     try
     {
         /* Kernel loader instance */
-        if(settings_instance.get_gpu())
+        if(settings_instance.get_gpu() || settings_instance.get_split() || settings_instance.get_multi_device() || settings_instance.get_transfer_bench())
         {
             kernel_loader &kernel_loader_instance = kernel_loader::instance();
             kernel_loader_instance.load();
         }
 
+        /* Pin the threads of the parallel backend, an explicit cpu list also sets their count */
+        if(settings_instance.get_affinity() != AFFINITY_NONE)
+        {
+            if(settings_instance.get_affinity() == AFFINITY_EXPLICIT)
+            {
+                set_parallel_thread_count(std::min(settings_instance.get_affinity_cpus().size(), get_parallel_max_thread_count()));
+            }
+
+            if(!set_parallel_affinity())
+            {
+                spdlog::warn("Some threads are not pinned (not supported or the cpus are not available)");
+            }
+        }
+
         /* Compute the test data on cpu */
         if(settings_instance.get_cpu())
         {
             compute_cpu cc(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
-            cc.run_all();
+            cc.set_execution_mode(settings_instance.get_cpu_mode());
+            cc.set_chunk_size(settings_instance.get_chunk_size());
+            cc.set_log_accuracy(settings_instance.get_log_accuracy());
+            cc.set_store_mode(settings_instance.get_store_mode());
+            cc.set_element_types(settings_instance.get_element_types());
+            cc.set_reduction_mode(settings_instance.get_reduction_mode());
+            cc.set_operations(settings_instance.get_operations());
+
+            /* The mapped dataset replaces the test data */
+            if(!settings_instance.get_input_a().empty())
+            {
+                cc.run_dataset(settings_instance.get_input_a(), settings_instance.get_input_b(), settings_instance.get_output());
+            }
+            else
+            {
+                cc.run_all();
+            }
+        }
+
+        /* Compute the fused expressions on cpu */
+        if(settings_instance.get_fusion())
+        {
+            compute_cpu cc(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
+            cc.set_execution_mode(settings_instance.get_cpu_mode());
+            cc.set_chunk_size(settings_instance.get_chunk_size());
+            cc.set_log_accuracy(settings_instance.get_log_accuracy());
+            cc.run_fusion();
+        }
+
+        /* Rerun the cpu tests at growing thread counts */
+        if(!settings_instance.get_scaling_file().empty())
+        {
+            compute_cpu cc(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
+            cc.set_execution_mode(settings_instance.get_cpu_mode());
+            cc.set_chunk_size(settings_instance.get_chunk_size());
+            cc.set_log_accuracy(settings_instance.get_log_accuracy());
+            cc.set_store_mode(settings_instance.get_store_mode());
+            cc.set_reduction_mode(settings_instance.get_reduction_mode());
+            cc.set_operations(settings_instance.get_operations());
+            cc.run_scaling(settings_instance.get_scaling_file());
+        }
+
+        /* Stream the files through the cpu tests, one pass */
+        if(!settings_instance.get_stream_directory().empty())
+        {
+            compute_cpu cc(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
+            cc.set_log_accuracy(settings_instance.get_log_accuracy());
+            cc.set_reduction_mode(settings_instance.get_reduction_mode());
+            cc.set_operations(settings_instance.get_operations());
+            cc.run_stream(settings_instance.get_stream_directory());
         }
 
         /* Compute the test data on gpu */
@@ -264,8 +842,37 @@ int main(int argc, char *argv[])
         {
             compute_gpu cg(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
             cg.print_info();
+            cg.set_tuning(settings_instance.get_tune_mode(), settings_instance.get_tune_cache());
+            cg.set_transfer_mode(settings_instance.get_transfer_mode());
+            cg.set_pipeline_chunks(settings_instance.get_pipeline_chunks());
             cg.run_all();
         }
+
+        /* Compute one vector on cpu and gpu together */
+        if(settings_instance.get_split())
+        {
+            compute_gpu cg(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
+            cg.set_log_accuracy(settings_instance.get_log_accuracy());
+            cg.set_operations(settings_instance.get_operations());
+            cg.set_tuning(settings_instance.get_tune_mode(), settings_instance.get_tune_cache());
+            cg.run_split();
+        }
+
+        /* Compute one vector on every OpenCL device */
+        if(settings_instance.get_multi_device())
+        {
+            compute_multi_device cm(settings_instance.get_vector_size(), settings_instance.get_iteration_count(), settings_instance.get_sub_devices());
+            cm.set_operations(settings_instance.get_operations());
+            cm.print_info();
+            cm.run_all();
+        }
+
+        /* Measure transfers between host and gpu */
+        if(settings_instance.get_transfer_bench())
+        {
+            compute_gpu cg(settings_instance.get_vector_size(), settings_instance.get_iteration_count());
+            cg.run_transfer_bench();
+        }
     }
     catch(std::exception const &e)
     {
@@ -376,6 +983,84 @@ void print_help()
     std::cout << "                                      7 - draw OpenCL particles with interoperability" << std::endl;
     std::cout << "                                      8 - draw OpenGL RGB cube" << std::endl;
     std::cout << "                                      9 - draw OpenGL RGB textured cube" << std::endl;
+    std::cout << "  -s, --simd <isa>                SIMD instruction set for cpu tests (default: auto)" << std::endl;
+    std::cout << "                                  --simd must be: auto, scalar, sse2, avx2 or avx512" << std::endl;
+    std::cout << "  -m, --cpu-mode <mode>           How cpu tests spread the work between threads (default: legacy)" << std::endl;
+    std::cout << "                                  --cpu-mode must be: legacy, chunked or blocked where:" << std::endl;
+    std::cout << "                                      legacy - every thread runs whole iterations over the whole vector" << std::endl;
+    std::cout << "                                      chunked - the vector is split between threads, iterations run inside each chunk" << std::endl;
+    std::cout << "                                      blocked - like chunked with L2 cache sized chunks, compared with whole vector sweeps" << std::endl;
+    std::cout << "  -k, --chunk-size <elements>     Elements per chunk in chunked mode (default: half of the L1 cache)" << std::endl;
+    std::cout << "  -a, --log-accuracy <accuracy>   Natural logarithm used by cpu tests (default: accurate)" << std::endl;
+    std::cout << "                                  --log-accuracy must be: std, accurate or fast where:" << std::endl;
+    std::cout << "                                      std - std::log" << std::endl;
+    std::cout << "                                      accurate - vectorized, at most 1 ULP" << std::endl;
+    std::cout << "                                      fast - vectorized, within 3 ULP" << std::endl;
+    std::cout << "  -f, --fusion                    Perform cpu tests of fused vector expressions" << std::endl;
+    std::cout << "  -n, --store-mode <mode>         How cpu tests write the result vector (default: regular)" << std::endl;
+    std::cout << "                                  --store-mode must be: regular, streaming or auto where:" << std::endl;
+    std::cout << "                                      regular - regular stores" << std::endl;
+    std::cout << "                                      streaming - non-temporal stores, the gain over regular stores is reported" << std::endl;
+    std::cout << "                                      auto - streaming stores when the working set exceeds the last level cache" << std::endl;
+    std::cout << "  -p, --parallel <backend>        What runs the parallel loops (default: openmp, pool if built without OpenMP)" << std::endl;
+    std::cout << "                                  --parallel must be: openmp or pool where:" << std::endl;
+    std::cout << "                                      openmp - OpenMP" << std::endl;
+    std::cout << "                                      pool - built-in work-stealing thread pool" << std::endl;
+    std::cout << "  -l, --pages <pages>             Pages of the benchmark vectors (default: thp)" << std::endl;
+    std::cout << "                                  --pages must be: default, thp or hugetlb where:" << std::endl;
+    std::cout << "                                      default - regular pages, 64 byte aligned" << std::endl;
+    std::cout << "                                      thp - 2 MiB aligned, transparent huge pages requested with madvise" << std::endl;
+    std::cout << "                                      hugetlb - reserved huge pages (MAP_HUGETLB), thp if there are none" << std::endl;
+    std::cout << "  -e, --element-types <types>     Element types of cpu tests, comma separated (default: float)" << std::endl;
+    std::cout << "                                  --element-types must be: all or float, double, int32, uint8, fp16, bf16 where:" << std::endl;
+    std::cout << "                                      fp16 - IEEE binary16, computed through float (F16C conversions on AVX2)" << std::endl;
+    std::cout << "                                      bf16 - bfloat16, computed through float" << std::endl;
+    std::cout << "  -r, --reduction <mode>          How cpu tests sum float reductions (default: simple)" << std::endl;
+    std::cout << "                                  --reduction must be: simple, pairwise or kahan where:" << std::endl;
+    std::cout << "                                      simple - unrolled SIMD accumulators" << std::endl;
+    std::cout << "                                      pairwise - the same on recursively halved ranges, summed pairwise" << std::endl;
+    std::cout << "                                      kahan - Kahan (compensated) summation in every SIMD lane" << std::endl;
+    std::cout << "  -x, --scaling <file>            Rerun float cpu tests at 1, 2, 4 ... N threads and write the table (CSV) to file" << std::endl;
+    std::cout << "                                  Prints speedup, parallel efficiency and where bandwidth saturates" << std::endl;
+    std::cout << "  -y, --affinity <policy>         How threads of cpu tests are pinned to cpus (default: none)" << std::endl;
+    std::cout << "                                  --affinity must be: none, compact, scatter or a cpu list where:" << std::endl;
+    std::cout << "                                      none - not pinned" << std::endl;
+    std::cout << "                                      compact - hardware threads of a core first, then the next cores of the same node" << std::endl;
+    std::cout << "                                      scatter - one thread per core alternating between NUMA nodes, hyper-threads last" << std::endl;
+    std::cout << "                                      cpu list - for example 0-3,8, thread p runs on the p-th cpu, sets the thread count" << std::endl;
+    std::cout << "  -o, --operations <operations>   Operations of cpu tests, comma separated (default: all)" << std::endl;
+    std::cout << "                                  --operations must be: all or " << get_operation_key_list() << std::endl;
+    std::cout << "  -z, --split                     Perform float tests on one vector split between cpu and gpu (OpenCL)" << std::endl;
+    std::cout << "                                  The split follows the measured throughput of both every iteration" << std::endl;
+    std::cout << "  -w, --stream <directory>        Run float cpu tests in one pass over a.bin and b.bin in directory, c.bin is written back" << std::endl;
+    std::cout << "                                  The files are raw float read and written in chunks on their own threads" << std::endl;
+    std::cout << "                                  a.bin and b.bin of --vector-size elements are written first if they don't exist" << std::endl;
+    std::cout << "  -A, --input-a <file>            Run cpu tests (-c) on the mapped file instead of the test data" << std::endl;
+    std::cout << "                                  Raw float or a 64 byte header (NYXDATA, version, element type, size, offset)" << std::endl;
+    std::cout << "                                  The element type is float, double, fp16 or bf16" << std::endl;
+    std::cout << "  -B, --input-b <file>            Second input of binary operations and dot, the element type of --input-a" << std::endl;
+    std::cout << "  -O, --output <file>             Mapped file (with the header) for the result of the last elementwise operation" << std::endl;
+    std::cout << "  -T, --tune <mode>               How gpu tests pick the local work-group size of kernels (default: auto)" << std::endl;
+    std::cout << "                                  --tune must be: off, auto or force where:" << std::endl;
+    std::cout << "                                      off - the OpenCL runtime picks it" << std::endl;
+    std::cout << "                                      auto - the size from the tuning cache, kernels without one are swept first" << std::endl;
+    std::cout << "                                      force - every kernel is swept again and the cache updated" << std::endl;
+    std::cout << "  -C, --tune-cache <file>         Tuning cache, one size per device, driver version and kernel (default: nyx_work_group.cache)" << std::endl;
+    std::cout << "  -X, --transfer <mode>           How gpu tests move the vectors to the device and back (default: copy)" << std::endl;
+    std::cout << "                                  --transfer must be: copy, host-pointer, host-allocated, pipeline or all where:" << std::endl;
+    std::cout << "                                      copy - device buffers, the vectors are copied in and the result out" << std::endl;
+    std::cout << "                                      host-pointer - the vectors are the buffers (CL_MEM_USE_HOST_PTR), the result is mapped" << std::endl;
+    std::cout << "                                      host-allocated - buffers in host memory of the runtime (CL_MEM_ALLOC_HOST_PTR), mapped" << std::endl;
+    std::cout << "                                      pipeline - chunks on three queues, uploads and downloads overlap kernels of other chunks" << std::endl;
+    std::cout << "                                      all - every mode side by side" << std::endl;
+    std::cout << "                                  Vectors larger than CL_DEVICE_MAX_MEM_ALLOC_SIZE always run as pipeline" << std::endl;
+    std::cout << "  -N, --pipeline-chunks <count>   Chunks of the vectors in the pipeline mode, more if a chunk doesn't fit the device (default: 8)" << std::endl;
+    std::cout << "  -M, --multi-device              Perform float tests on one vector sharded across every OpenCL device of every platform" << std::endl;
+    std::cout << "                                  The shards follow the measured throughput of the devices every iteration" << std::endl;
+    std::cout << "  -D, --sub-devices <count>       Partition every cpu OpenCL device into count sub-devices for --multi-device (POCL for example)" << std::endl;
+    std::cout << "  -R, --transfer-bench            Measure host and OpenCL device transfers from 4 KiB to the largest buffer" << std::endl;
+    std::cout << "                                  Write, read, copy and map bandwidth and latency, pageable and pinned host memory" << std::endl;
+    std::cout << "                                  and the size from which addition on the device (transfers included) beats the cpu" << std::endl;
     std::cout << "  -b, --verbose                   Verbose output" << std::endl;
     std::cout << "  -h, --help                      Display help information and exit" << std::endl;
     std::cout << "  -u, --build-info                Display build information end exit" << std::endl;
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Parallel loop over a range on the selected backend (OpenMP or the thread pool)
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef CORE_PARALLEL_FOR_H
+#define CORE_PARALLEL_FOR_H
+
+#include "core/settings.h"
+#include "core/thread_pool.h"
+#include "platform/cpu_topology.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/* Elements per range for simple elementwise loops */
+constexpr std::size_t parallel_for_grain = 16384;
+
+/* Threads parallel_for runs on with the selected backend */
+inline std::size_t get_parallel_thread_count()
+{
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+            return thread_pool::instance().get_thread_count();
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+#ifdef _OPENMP
+            return static_cast<std::size_t>(omp_get_max_threads());
+#else
+            return 1;
+#endif
+    }
+}
+
+/* Threads parallel_for can use at most: the available processors */
+inline std::size_t get_parallel_max_thread_count()
+{
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+            return thread_pool::instance().get_max_thread_count();
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+#ifdef _OPENMP
+            return static_cast<std::size_t>(omp_get_num_procs());
+#else
+            return 1;
+#endif
+    }
+}
+
+/* Logical CPUs of the threads of parallel_for in order (part p of a range runs on cpus[p]), empty if they are not pinned */
+inline std::vector<std::size_t> get_parallel_affinity_cpus()
+{
+    switch(settings::instance().get_affinity())
+    {
+        case AFFINITY_COMPACT:
+            return cpu_topology::instance().get_compact_order();
+        case AFFINITY_SCATTER:
+            return cpu_topology::instance().get_scatter_order();
+        case AFFINITY_EXPLICIT:
+            return settings::instance().get_affinity_cpus();
+        case AFFINITY_NONE:
+        default:
+            return std::vector<std::size_t>();
+    }
+}
+
+/* Pin the threads of the selected backend with the affinity policy from settings, false if a thread couldn't be pinned */
+inline bool set_parallel_affinity()
+{
+    std::vector<std::size_t> cpus = get_parallel_affinity_cpus();
+
+    if(cpus.empty())
+    {
+        return true;
+    }
+
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+            return thread_pool::instance().set_affinity(cpus);
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+        {
+#ifdef _OPENMP
+            bool pinned = true;
+
+            /* Thread p of the team runs part p of schedule(static) loops */
+#pragma omp parallel reduction(&& : pinned)
+            {
+                pinned = cpu_topology::pin_current_thread(cpus[static_cast<std::size_t>(omp_get_thread_num()) % cpus.size()]);
+            }
+
+            return pinned;
+#else
+            return cpu_topology::pin_current_thread(cpus[0]);
+#endif
+        }
+    }
+}
+
+/* Run parallel_for on count threads */
+inline void set_parallel_thread_count(std::size_t const &count)
+{
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+            thread_pool::instance().set_thread_count(count);
+            break;
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+#ifdef _OPENMP
+            omp_set_num_threads(static_cast<int>(std::max<std::size_t>(count, 1)));
+
+            /* A larger team may start new threads */
+            set_parallel_affinity();
+#endif
+            break;
+    }
+}
+
+/*
+    Calls function(range_begin, range_end) for consecutive ranges of at most
+    grain elements that cover [begin, end), in parallel on the backend
+    selected in settings. Both backends hand out contiguous parts of the
+    range per thread (schedule(static)), the thread pool also balances the
+    parts by work stealing.
+*/
+template<typename function_type>
+void parallel_for(std::size_t const &begin, std::size_t const &end, std::size_t const &grain, function_type const &function)
+{
+    if(end <= begin)
+    {
+        return;
+    }
+
+    std::size_t step = std::max<std::size_t>(grain, 1);
+
+    switch(settings::instance().get_parallel_backend())
+    {
+        case PARALLEL_BACKEND_THREAD_POOL:
+        {
+            thread_pool::instance().run(begin, end, step, function);
+            break;
+        }
+        case PARALLEL_BACKEND_OPENMP:
+        default:
+        {
+            std::size_t count = (end - begin + step - 1) / step;
+
+#pragma omp parallel for schedule(static)
+            for(std::size_t i = 0; i < count; i++)
+            {
+                std::size_t range_begin = begin + (i * step);
+                function(range_begin, std::min(end, range_begin + step));
+            }
+            break;
+        }
+    }
+}
+
+#endif // CORE_PARALLEL_FOR_H
@@ -96,4 +96,254 @@ bool settings::get_exit()
 void settings::set_exit(bool const &exit)
 {
     this->exit = exit;
+}
+
+cpu_execution_mode settings::get_cpu_mode()
+{
+    return cpu_mode;
+}
+
+void settings::set_cpu_mode(cpu_execution_mode const &cpu_mode)
+{
+    this->cpu_mode = cpu_mode;
+}
+
+std::size_t settings::get_chunk_size()
+{
+    return chunk_size;
+}
+
+void settings::set_chunk_size(std::size_t const &chunk_size)
+{
+    this->chunk_size = chunk_size;
+}
+
+log_accuracy settings::get_log_accuracy()
+{
+    return accuracy;
+}
+
+void settings::set_log_accuracy(log_accuracy const &accuracy)
+{
+    this->accuracy = accuracy;
+}
+
+bool settings::get_fusion()
+{
+    return fusion;
+}
+
+void settings::set_fusion(bool const &fusion)
+{
+    this->fusion = fusion;
+}
+
+cpu_store_mode settings::get_store_mode()
+{
+    return store_mode;
+}
+
+void settings::set_store_mode(cpu_store_mode const &store_mode)
+{
+    this->store_mode = store_mode;
+}
+
+parallel_backend settings::get_parallel_backend()
+{
+    return backend;
+}
+
+void settings::set_parallel_backend(parallel_backend const &backend)
+{
+    this->backend = backend;
+}
+
+page_mode settings::get_page_mode()
+{
+    return pages;
+}
+
+void settings::set_page_mode(page_mode const &pages)
+{
+    this->pages = pages;
+}
+
+std::vector<element_type> const &settings::get_element_types()
+{
+    return element_types;
+}
+
+void settings::set_element_types(std::vector<element_type> const &element_types)
+{
+    this->element_types = element_types;
+}
+
+reduction_mode settings::get_reduction_mode()
+{
+    return reduction;
+}
+
+void settings::set_reduction_mode(reduction_mode const &reduction)
+{
+    this->reduction = reduction;
+}
+
+std::string const &settings::get_scaling_file()
+{
+    return scaling_file;
+}
+
+void settings::set_scaling_file(std::string const &scaling_file)
+{
+    this->scaling_file = scaling_file;
+}
+
+affinity_policy settings::get_affinity()
+{
+    return affinity;
+}
+
+void settings::set_affinity(affinity_policy const &affinity)
+{
+    this->affinity = affinity;
+}
+
+std::vector<std::size_t> const &settings::get_affinity_cpus()
+{
+    return affinity_cpus;
+}
+
+void settings::set_affinity_cpus(std::vector<std::size_t> const &affinity_cpus)
+{
+    this->affinity_cpus = affinity_cpus;
+}
+
+std::vector<std::string> const &settings::get_operations()
+{
+    return operations;
+}
+
+void settings::set_operations(std::vector<std::string> const &operations)
+{
+    this->operations = operations;
+}
+
+bool settings::get_split()
+{
+    return split;
+}
+
+void settings::set_split(bool const &split)
+{
+    this->split = split;
+}
+
+std::string const &settings::get_stream_directory()
+{
+    return stream_directory;
+}
+
+void settings::set_stream_directory(std::string const &stream_directory)
+{
+    this->stream_directory = stream_directory;
+}
+
+std::string const &settings::get_input_a()
+{
+    return input_a;
+}
+
+void settings::set_input_a(std::string const &input_a)
+{
+    this->input_a = input_a;
+}
+
+std::string const &settings::get_input_b()
+{
+    return input_b;
+}
+
+void settings::set_input_b(std::string const &input_b)
+{
+    this->input_b = input_b;
+}
+
+std::string const &settings::get_output()
+{
+    return output;
+}
+
+void settings::set_output(std::string const &output)
+{
+    this->output = output;
+}
+
+tune_mode settings::get_tune_mode()
+{
+    return tune;
+}
+
+void settings::set_tune_mode(tune_mode const &tune)
+{
+    this->tune = tune;
+}
+
+std::string const &settings::get_tune_cache()
+{
+    return tune_cache;
+}
+
+void settings::set_tune_cache(std::string const &tune_cache)
+{
+    this->tune_cache = tune_cache;
+}
+
+transfer_mode settings::get_transfer_mode()
+{
+    return transfer;
+}
+
+void settings::set_transfer_mode(transfer_mode const &transfer)
+{
+    this->transfer = transfer;
+}
+
+std::size_t settings::get_pipeline_chunks()
+{
+    return pipeline_chunks;
+}
+
+void settings::set_pipeline_chunks(std::size_t const &pipeline_chunks)
+{
+    this->pipeline_chunks = pipeline_chunks;
+}
+
+bool settings::get_multi_device()
+{
+    return multi_device;
+}
+
+void settings::set_multi_device(bool const &multi_device)
+{
+    this->multi_device = multi_device;
+}
+
+std::size_t settings::get_sub_devices()
+{
+    return sub_devices;
+}
+
+void settings::set_sub_devices(std::size_t const &sub_devices)
+{
+    this->sub_devices = sub_devices;
+}
+
+bool settings::get_transfer_bench()
+{
+    return transfer_bench;
+}
+
+void settings::set_transfer_bench(bool const &transfer_bench)
+{
+    this->transfer_bench = transfer_bench;
 }
\ No newline at end of file
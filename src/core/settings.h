@@ -28,6 +28,94 @@
 #define CORE_SETTINGS_H
 
 #include <cstddef>
+#include <string>
+#include <vector>
+
+/* How compute_cpu spreads the work between threads */
+enum cpu_execution_mode
+{
+    CPU_MODE_LEGACY,  /* Every thread runs whole iterations over the whole vector */
+    CPU_MODE_CHUNKED, /* The vector is split into chunks between threads, iterations run inside each chunk */
+    CPU_MODE_BLOCKED, /* Like CPU_MODE_CHUNKED with L2 sized chunks (tiles) derived from the detected caches */
+    CPU_MODE_SWEEP    /* Every iteration sweeps the whole vector split between threads (the baseline of CPU_MODE_BLOCKED) */
+};
+
+/* Which natural logarithm compute_cpu uses for float vectors */
+enum log_accuracy
+{
+    LOG_ACCURACY_STD,      /* std::log */
+    LOG_ACCURACY_ACCURATE, /* Vectorized, at most 1 ULP */
+    LOG_ACCURACY_FAST      /* Vectorized, within 3 ULP */
+};
+
+/* What runs the parallel loops (see core/parallel_for.h) */
+enum parallel_backend
+{
+    PARALLEL_BACKEND_OPENMP,     /* OpenMP pragmas, serial if the application is built without OpenMP */
+    PARALLEL_BACKEND_THREAD_POOL /* Built-in work-stealing thread pool */
+};
+
+/* How compute_cpu writes the result vector */
+enum cpu_store_mode
+{
+    STORE_MODE_REGULAR,   /* Regular stores */
+    STORE_MODE_STREAMING, /* Non-temporal (streaming) stores */
+    STORE_MODE_AUTO       /* Streaming stores when the working set doesn't fit in the last level cache */
+};
+
+/* Which pages back the benchmark vectors (see core/huge_page_allocator.h) */
+enum page_mode
+{
+    PAGE_MODE_DEFAULT,     /* Regular pages, 64 byte aligned */
+    PAGE_MODE_TRANSPARENT, /* 2 MiB aligned, transparent huge pages requested with madvise */
+    PAGE_MODE_HUGETLB      /* Reserved huge pages (MAP_HUGETLB), transparent huge pages if there are none */
+};
+
+/* How compute_cpu sums float reductions (minimum and maximum are exact in every mode) */
+enum reduction_mode
+{
+    REDUCTION_MODE_SIMPLE,   /* Unrolled SIMD accumulators */
+    REDUCTION_MODE_PAIRWISE, /* The same on recursively halved ranges, summed pairwise */
+    REDUCTION_MODE_KAHAN     /* Kahan (compensated) summation in every SIMD lane */
+};
+
+/* How the threads of the parallel backend are pinned to logical CPUs (see platform/cpu_topology.h) */
+enum affinity_policy
+{
+    AFFINITY_NONE,    /* Not pinned, the scheduler may migrate them */
+    AFFINITY_COMPACT, /* Hardware threads of a core first, then the next cores of the same node */
+    AFFINITY_SCATTER, /* One thread per core alternating between the nodes, hardware threads of the cores last */
+    AFFINITY_EXPLICIT /* The given cpulist in order */
+};
+
+/* Element types of the compute_cpu benchmarks */
+enum element_type
+{
+    ELEMENT_FLOAT,
+    ELEMENT_DOUBLE,
+    ELEMENT_INT32,
+    ELEMENT_UINT8,
+    ELEMENT_FLOAT16, /* IEEE binary16, computed through float */
+    ELEMENT_BFLOAT16 /* bfloat16, computed through float */
+};
+
+/* How compute_gpu picks the local work-group size of its kernels (see compute/work_group_tuner.h) */
+enum tune_mode
+{
+    TUNE_MODE_OFF,  /* The runtime picks it (cl::NullRange) */
+    TUNE_MODE_AUTO, /* The size from the tuning cache, kernels without one are swept first */
+    TUNE_MODE_FORCE /* Every kernel is swept again and the cache updated */
+};
+
+/* How compute_gpu moves the vectors to the device and back */
+enum transfer_mode
+{
+    TRANSFER_MODE_COPY,           /* Device buffers, the vectors are copied in and the result out */
+    TRANSFER_MODE_HOST_POINTER,   /* The vectors are the buffers (CL_MEM_USE_HOST_PTR), the result is mapped */
+    TRANSFER_MODE_HOST_ALLOCATED, /* Buffers in host memory of the runtime (CL_MEM_ALLOC_HOST_PTR), mapped */
+    TRANSFER_MODE_PIPELINE,       /* Chunks on three queues, transfers of a chunk overlap kernels of another */
+    TRANSFER_MODE_ALL             /* Every mode, side by side */
+};
 
 class settings
 {
@@ -47,6 +135,31 @@ public:
     std::size_t get_laboratory_work();
     bool get_verbose();
     bool get_exit();
+    cpu_execution_mode get_cpu_mode();
+    std::size_t get_chunk_size();
+    log_accuracy get_log_accuracy();
+    bool get_fusion();
+    cpu_store_mode get_store_mode();
+    parallel_backend get_parallel_backend();
+    page_mode get_page_mode();
+    std::vector<element_type> const &get_element_types();
+    reduction_mode get_reduction_mode();
+    std::string const &get_scaling_file();
+    affinity_policy get_affinity();
+    std::vector<std::size_t> const &get_affinity_cpus();
+    std::vector<std::string> const &get_operations();
+    bool get_split();
+    std::string const &get_stream_directory();
+    std::string const &get_input_a();
+    std::string const &get_input_b();
+    std::string const &get_output();
+    tune_mode get_tune_mode();
+    std::string const &get_tune_cache();
+    transfer_mode get_transfer_mode();
+    std::size_t get_pipeline_chunks();
+    bool get_multi_device();
+    std::size_t get_sub_devices();
+    bool get_transfer_bench();
 
     void set_gpu(bool const &gpu);
     void set_cpu(bool const &cpu);
@@ -55,6 +168,31 @@ public:
     void set_laboratory_work(std::size_t const &laboratory_work);
     void set_verbose(bool const &verbose);
     void set_exit(bool const &exit);
+    void set_cpu_mode(cpu_execution_mode const &cpu_mode);
+    void set_chunk_size(std::size_t const &chunk_size);
+    void set_log_accuracy(log_accuracy const &accuracy);
+    void set_fusion(bool const &fusion);
+    void set_store_mode(cpu_store_mode const &store_mode);
+    void set_parallel_backend(parallel_backend const &backend);
+    void set_page_mode(page_mode const &pages);
+    void set_element_types(std::vector<element_type> const &element_types);
+    void set_reduction_mode(reduction_mode const &reduction);
+    void set_scaling_file(std::string const &scaling_file);
+    void set_affinity(affinity_policy const &affinity);
+    void set_affinity_cpus(std::vector<std::size_t> const &affinity_cpus);
+    void set_operations(std::vector<std::string> const &operations);
+    void set_split(bool const &split);
+    void set_stream_directory(std::string const &stream_directory);
+    void set_input_a(std::string const &input_a);
+    void set_input_b(std::string const &input_b);
+    void set_output(std::string const &output);
+    void set_tune_mode(tune_mode const &tune);
+    void set_tune_cache(std::string const &tune_cache);
+    void set_transfer_mode(transfer_mode const &transfer);
+    void set_pipeline_chunks(std::size_t const &pipeline_chunks);
+    void set_multi_device(bool const &multi_device);
+    void set_sub_devices(std::size_t const &sub_devices);
+    void set_transfer_bench(bool const &transfer_bench);
 
 private:
     /* Class */
@@ -70,6 +208,35 @@ private:
     std::size_t laboratory_work = 0;
     bool verbose                = false;
     bool exit                   = false;
+    cpu_execution_mode cpu_mode = CPU_MODE_LEGACY;
+    std::size_t chunk_size      = 0;
+    log_accuracy accuracy       = LOG_ACCURACY_ACCURATE;
+    bool fusion                 = false;
+    cpu_store_mode store_mode   = STORE_MODE_REGULAR;
+    page_mode pages             = PAGE_MODE_TRANSPARENT;
+    std::vector<element_type> element_types {ELEMENT_FLOAT};
+    reduction_mode reduction    = REDUCTION_MODE_SIMPLE;
+    std::string scaling_file;
+    affinity_policy affinity    = AFFINITY_NONE;
+    std::vector<std::size_t> affinity_cpus;
+    std::vector<std::string> operations;
+    bool split                  = false;
+    std::string stream_directory;
+    std::string input_a;
+    std::string input_b;
+    std::string output;
+    tune_mode tune              = TUNE_MODE_AUTO;
+    std::string tune_cache      = "nyx_work_group.cache";
+    transfer_mode transfer      = TRANSFER_MODE_COPY;
+    std::size_t pipeline_chunks = 8;
+    bool multi_device           = false;
+    std::size_t sub_devices     = 0;
+    bool transfer_bench         = false;
+#ifdef _OPENMP
+    parallel_backend backend = PARALLEL_BACKEND_OPENMP;
+#else
+    parallel_backend backend = PARALLEL_BACKEND_THREAD_POOL;
+#endif
 };
 
 #endif // CORE_SETTINGS_H
\ No newline at end of file
@@ -0,0 +1,274 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Work-stealing thread pool
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "core/thread_pool.h"
+
+#include "platform/cpu_topology.h"
+
+namespace
+{
+    /* Is the current thread running a task of the pool (worker or caller inside run()) */
+    thread_local bool inside_pool = false;
+
+    /* Splits [begin, end) at a multiple of grain from begin, so every range but the last is a multiple of grain */
+    std::size_t split(std::size_t const &begin, std::size_t const &end, std::size_t const &grain, std::size_t const &parts, std::size_t const &part)
+    {
+        std::size_t grains = (end - begin + grain - 1) / grain;
+        return std::min(end, begin + ((grains * part) / parts) * grain);
+    }
+} // namespace
+
+thread_pool::thread_pool()
+{
+    std::size_t thread_count = std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+
+    for(std::size_t i = 0; i < thread_count; i++)
+    {
+        queues.emplace_back(new task_queue);
+    }
+
+    active = thread_count;
+
+    /* The last queue belongs to the calling thread */
+    for(std::size_t i = 0; i + 1 < thread_count; i++)
+    {
+        workers.emplace_back(&thread_pool::worker, this, i);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stop = true;
+    }
+
+    wake.notify_all();
+
+    for(std::thread &t : workers)
+    {
+        t.join();
+    }
+}
+
+std::size_t thread_pool::get_thread_count() const
+{
+    return active.load();
+}
+
+std::size_t thread_pool::get_max_thread_count() const
+{
+    return queues.size();
+}
+
+void thread_pool::set_thread_count(std::size_t const &count)
+{
+    active = std::min(std::max<std::size_t>(count, 1), queues.size());
+}
+
+bool thread_pool::set_affinity(std::vector<std::size_t> const &cpus)
+{
+    if(cpus.empty())
+    {
+        return false;
+    }
+
+    /* The caller runs the first part of every range, worker i the part i + 1 */
+    bool pinned = cpu_topology::pin_current_thread(cpus[0]);
+
+    for(std::size_t i = 0; i < workers.size(); i++)
+    {
+        pinned = cpu_topology::pin_thread(workers[i], cpus[(i + 1) % cpus.size()]) && pinned;
+    }
+
+    return pinned;
+}
+
+void thread_pool::submit(job &j, std::size_t const &begin, std::size_t const &end)
+{
+    /* Nested call, every thread is already busy */
+    if(inside_pool)
+    {
+        for(std::size_t b = begin; b < end; b += std::min(j.grain, end - b))
+        {
+            j.invoke(j.function, b, b + std::min(j.grain, end - b));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> caller_lock(caller_mutex);
+
+    inside_pool        = true;
+    std::size_t caller = queues.size() - 1;
+    std::size_t parts  = active.load();
+
+    j.remaining = end - begin;
+
+    /*
+        One contiguous part per active thread: the first part is the caller's, part p
+        goes to worker p - 1 (like thread p of an OpenMP team). The caller's part is pushed last
+    */
+    for(std::size_t part = parts; part-- > 0;)
+    {
+        std::size_t part_begin = split(begin, end, j.grain, parts, part);
+        std::size_t part_end   = split(begin, end, j.grain, parts, part + 1);
+
+        if(part_begin < part_end)
+        {
+            push((part > 0) ? part - 1 : caller, task {&j, part_begin, part_end});
+        }
+    }
+
+    task t;
+    while(pop(caller, t) || steal(caller, t))
+    {
+        execute(caller, t);
+    }
+
+    inside_pool = false;
+
+    /* The rest of the ranges are running on the workers */
+    std::unique_lock<std::mutex> lock(j.mutex);
+    j.done.wait(
+        lock,
+        [&j]()
+        {
+            return j.finished;
+        });
+}
+
+void thread_pool::push(std::size_t const &queue, task const &t)
+{
+    /* Counted before it can be taken, so pending never drops below zero */
+    pending++;
+
+    {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        queues[queue]->tasks.push_back(t);
+    }
+
+    if(sleeping.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+
+        /* Inactive workers go back to sleep, the wake up must reach an active one */
+        if(active.load() < queues.size())
+            wake.notify_all();
+        else
+            wake.notify_one();
+    }
+}
+
+bool thread_pool::pop(std::size_t const &queue, task &t)
+{
+    std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+
+    if(queues[queue]->tasks.empty())
+    {
+        return false;
+    }
+
+    t = queues[queue]->tasks.back();
+    queues[queue]->tasks.pop_back();
+    pending--;
+    return true;
+}
+
+bool thread_pool::steal(std::size_t const &thief, task &t)
+{
+    for(std::size_t n = 1; n < queues.size(); n++)
+    {
+        task_queue &victim = *queues[(thief + n) % queues.size()];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if(!victim.tasks.empty())
+        {
+            t = victim.tasks.front();
+            victim.tasks.pop_front();
+            pending--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void thread_pool::execute(std::size_t const &queue, task t)
+{
+    job &j = *t.owner;
+
+    /* Keep the lower half, leave the upper half for this thread or a thief */
+    while((t.end - t.begin) > j.grain)
+    {
+        std::size_t middle = split(t.begin, t.end, j.grain, 2, 1);
+        push(queue, task {&j, middle, t.end});
+        t.end = middle;
+    }
+
+    j.invoke(j.function, t.begin, t.end);
+
+    std::size_t count = t.end - t.begin;
+
+    if(j.remaining.fetch_sub(count) == count)
+    {
+        std::lock_guard<std::mutex> lock(j.mutex);
+        j.finished = true;
+        j.done.notify_all();
+    }
+}
+
+void thread_pool::worker(std::size_t const &queue)
+{
+    inside_pool = true;
+
+    while(true)
+    {
+        /* Inactive workers only sleep (see set_thread_count) */
+        task t;
+        if(((queue + 1) < active.load()) && (pop(queue, t) || steal(queue, t)))
+        {
+            execute(queue, t);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+
+        sleeping++;
+        wake.wait(
+            lock,
+            [this, &queue]()
+            {
+                return stop || ((pending.load() > 0) && ((queue + 1) < active.load()));
+            });
+        sleeping--;
+
+        if(stop)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,178 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Work-stealing thread pool
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef CORE_THREAD_POOL_H
+#define CORE_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Every thread has its own deque of ranges guarded by its own mutex, there
+    is no global queue. run() cuts the range into one contiguous part per
+    thread (like schedule(static)). A thread takes ranges from the back of
+    its own deque and splits them in halves, pushing the upper half back,
+    until a range is not longer than grain. Threads that run out of work
+    steal from the front of the other deques, which holds the largest ranges.
+
+    The calling thread takes part in the work, so a pool on a single core
+    machine has no workers at all and runs everything in the caller.
+*/
+class thread_pool
+{
+public:
+    /* Class */
+    static thread_pool &instance()
+    {
+        static thread_pool tp;
+        return tp;
+    }
+
+    /* Count of threads that run the work (workers and the calling thread) */
+    std::size_t get_thread_count() const;
+
+    /* Count of threads the pool is created with (hardware threads) */
+    std::size_t get_max_thread_count() const;
+
+    /*
+        Use only count threads (clamped to [1, get_max_thread_count()]),
+        the other workers sleep. Must not be called while run() is running
+    */
+    void set_thread_count(std::size_t const &count);
+
+    /*
+        Pin the calling thread to cpus[0] and worker i to cpus[i + 1] (cpus are reused
+        when there are fewer of them), so part p of every range runs on cpus[p].
+        false if a thread couldn't be pinned
+    */
+    bool set_affinity(std::vector<std::size_t> const &cpus);
+
+    /*
+        Calls function(range_begin, range_end) for consecutive ranges of at most grain
+        elements that cover [begin, end) and returns when all of them are done
+        Calls from inside a running function are executed serially
+    */
+    template<typename function_type>
+    void run(std::size_t const &begin, std::size_t const &end, std::size_t const &grain, function_type const &function);
+
+private:
+    /* Class */
+    thread_pool();
+    ~thread_pool();
+    thread_pool(thread_pool const &)            = delete;
+    thread_pool &operator=(thread_pool const &) = delete;
+
+    /* One call of run() */
+    struct job
+    {
+        void (*invoke)(void const *function, std::size_t begin, std::size_t end) = nullptr;
+        void const *function                                                      = nullptr;
+        std::size_t grain                                                         = 1;
+
+        /* Elements that are not processed yet */
+        std::atomic<std::size_t> remaining {0};
+
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+    };
+
+    struct task
+    {
+        job *owner        = nullptr;
+        std::size_t begin = 0;
+        std::size_t end   = 0;
+    };
+
+    struct task_queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    template<typename function_type>
+    static void invoke(void const *function, std::size_t begin, std::size_t end)
+    {
+        (*static_cast<function_type const *>(function))(begin, end);
+    }
+
+    void submit(job &j, std::size_t const &begin, std::size_t const &end);
+
+    void push(std::size_t const &queue, task const &t);
+    bool pop(std::size_t const &queue, task &t);
+    bool steal(std::size_t const &thief, task &t);
+
+    /* Splits the task down to the grain and runs it */
+    void execute(std::size_t const &queue, task t);
+
+    void worker(std::size_t const &queue);
+
+    /* Variables */
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::vector<std::thread> workers;
+
+    /* Tasks in all queues and sleeping workers, used only to put idle workers to sleep */
+    std::atomic<std::size_t> pending {0};
+    std::atomic<std::size_t> sleeping {0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop = false;
+
+    /* The calling thread uses the last queue, so callers from different threads take turns */
+    std::mutex caller_mutex;
+
+    /* Threads that take part in run(): the first active - 1 workers and the caller */
+    std::atomic<std::size_t> active {1};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename function_type>
+void thread_pool::run(std::size_t const &begin, std::size_t const &end, std::size_t const &grain, function_type const &function)
+{
+    if(end <= begin)
+    {
+        return;
+    }
+
+    std::size_t step = std::max<std::size_t>(grain, 1);
+
+    job j;
+    j.invoke   = &invoke<function_type>;
+    j.function = &function;
+    j.grain    = step;
+
+    submit(j, begin, end);
+}
+
+#endif // CORE_THREAD_POOL_H
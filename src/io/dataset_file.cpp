@@ -0,0 +1,246 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Memory-mapped binary dataset files (raw float or with a self-describing header)
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "io/dataset_file.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define NYX_DATASET_FILE_LINUX
+#endif
+
+namespace
+{
+    char const dataset_magic[8] = {'N', 'Y', 'X', 'D', 'A', 'T', 'A', '\0'};
+
+    std::uint32_t const dataset_version = 1;
+
+    /* The elements start at a cache line, which is a multiple of every element size */
+    std::uint64_t const dataset_alignment = 64;
+} // namespace
+
+dataset_file::dataset_file(std::string const &path)
+{
+    this->path = path;
+
+#ifdef NYX_DATASET_FILE_LINUX
+    int descriptor = open(path.c_str(), O_RDONLY);
+
+    if(descriptor < 0)
+    {
+        throw std::runtime_error("Failed opening dataset: " + path);
+    }
+
+    struct stat status;
+
+    if((fstat(descriptor, &status) != 0) || (status.st_size == 0))
+    {
+        close(descriptor);
+        throw std::runtime_error("Failed reading dataset (or it is empty): " + path);
+    }
+
+    mapping_size = static_cast<std::size_t>(status.st_size);
+    device       = static_cast<std::uint64_t>(status.st_dev);
+    inode        = static_cast<std::uint64_t>(status.st_ino);
+    mapping      = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    /* The mapping keeps the file */
+    close(descriptor);
+
+    if(mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw std::runtime_error("Failed mapping dataset: " + path);
+    }
+
+    dataset_header const *h = static_cast<dataset_header const *>(mapping);
+
+    if((mapping_size >= sizeof(dataset_header)) && (std::memcmp(h->magic, dataset_magic, sizeof(dataset_magic)) == 0))
+    {
+        if((h->version != dataset_version) || (h->type > ELEMENT_BFLOAT16) || (h->offset < sizeof(dataset_header)) || (h->offset > mapping_size) ||
+           ((h->offset % dataset_alignment) != 0))
+        {
+            munmap(mapping, mapping_size);
+            throw std::runtime_error("Unsupported dataset header: " + path);
+        }
+
+        header = true;
+        type   = static_cast<element_type>(h->type);
+        offset = h->offset;
+        size   = h->size;
+
+        if(size > ((mapping_size - offset) / get_element_size(type)))
+        {
+            munmap(mapping, mapping_size);
+            throw std::runtime_error("Dataset is shorter than its header says: " + path);
+        }
+    }
+    else
+    {
+        /* Raw float */
+        size = mapping_size / sizeof(float);
+    }
+
+    /* The benchmarks sweep the whole file, read it ahead */
+    madvise(mapping, mapping_size, MADV_WILLNEED);
+#else
+    throw std::runtime_error("Mapped datasets are supported on Linux only: " + path);
+#endif
+}
+
+dataset_file::dataset_file(std::string const &path, element_type const &type, std::size_t const &size)
+{
+    this->path     = path;
+    this->type     = type;
+    this->size     = size;
+    this->offset   = sizeof(dataset_header);
+    this->header   = true;
+    this->writable = true;
+
+#ifdef NYX_DATASET_FILE_LINUX
+    mapping_size = offset + (size * get_element_size(type));
+
+    int descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if(descriptor < 0)
+    {
+        throw std::runtime_error("Failed creating dataset: " + path);
+    }
+
+    if(ftruncate(descriptor, static_cast<off_t>(mapping_size)) != 0)
+    {
+        close(descriptor);
+        throw std::runtime_error("Failed resizing dataset: " + path);
+    }
+
+    struct stat status;
+
+    if(fstat(descriptor, &status) == 0)
+    {
+        device = static_cast<std::uint64_t>(status.st_dev);
+        inode  = static_cast<std::uint64_t>(status.st_ino);
+    }
+
+    mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+    close(descriptor);
+
+    if(mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw std::runtime_error("Failed mapping dataset: " + path);
+    }
+
+    dataset_header h = {};
+
+    std::memcpy(h.magic, dataset_magic, sizeof(dataset_magic));
+    h.version = dataset_version;
+    h.type    = static_cast<std::uint32_t>(type);
+    h.size    = size;
+    h.offset  = offset;
+
+    std::memcpy(mapping, &h, sizeof(h));
+#else
+    throw std::runtime_error("Mapped datasets are supported on Linux only: " + path);
+#endif
+}
+
+dataset_file::~dataset_file()
+{
+#ifdef NYX_DATASET_FILE_LINUX
+    if(mapping != nullptr)
+    {
+        munmap(mapping, mapping_size);
+    }
+#endif
+}
+
+element_type dataset_file::get_type() const
+{
+    return type;
+}
+
+std::size_t dataset_file::get_size() const
+{
+    return size;
+}
+
+bool dataset_file::has_header() const
+{
+    return header;
+}
+
+bool dataset_file::is_same_file(std::string const &path) const
+{
+#ifdef NYX_DATASET_FILE_LINUX
+    struct stat status;
+
+    /* A path that doesn't exist yet is a new file */
+    if(stat(path.c_str(), &status) != 0)
+    {
+        return false;
+    }
+
+    return (static_cast<std::uint64_t>(status.st_dev) == device) && (static_cast<std::uint64_t>(status.st_ino) == inode);
+#else
+    return false;
+#endif
+}
+
+void dataset_file::sync()
+{
+#ifdef NYX_DATASET_FILE_LINUX
+    if(writable && (msync(mapping, mapping_size, MS_SYNC) != 0))
+    {
+        throw std::runtime_error("Failed writing dataset: " + path);
+    }
+#endif
+}
+
+std::size_t dataset_file::get_element_size(element_type const &type)
+{
+    switch(type)
+    {
+        case ELEMENT_DOUBLE:
+            return sizeof(double);
+        case ELEMENT_INT32:
+            return sizeof(std::int32_t);
+        case ELEMENT_UINT8:
+            return sizeof(std::uint8_t);
+        case ELEMENT_FLOAT16:
+        case ELEMENT_BFLOAT16:
+            return sizeof(std::uint16_t);
+        case ELEMENT_FLOAT:
+        default:
+            return sizeof(float);
+    }
+}
@@ -0,0 +1,120 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Memory-mapped binary dataset files (raw float or with a self-describing header)
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef IO_DATASET_FILE_H
+#define IO_DATASET_FILE_H
+
+#include "core/settings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/*
+    Header at the start of a dataset file, the elements follow at offset.
+    type is the value of element_type, so the order of the enum is part of
+    the format. The header is 64 bytes and offset must be a multiple of 64,
+    the elements of a mapped file stay cache line aligned
+*/
+struct dataset_header
+{
+    char magic[8];             /* "NYXDATA" */
+    std::uint32_t version;     /* 1 */
+    std::uint32_t type;        /* element_type */
+    std::uint64_t size;        /* Elements */
+    std::uint64_t offset;      /* Bytes before the first element */
+    std::uint8_t reserved[32]; /* Zero */
+};
+
+static_assert(sizeof(dataset_header) == 64, "dataset_header must be 64 bytes");
+
+/*
+    A dataset file mapped into memory (Linux only, mmap). The engines run on
+    the mapped pages directly, nothing is copied. A file without the header
+    is raw float, every byte is data
+*/
+class dataset_file
+{
+public:
+    /* Map an existing file for reading */
+    explicit dataset_file(std::string const &path);
+
+    /* Create (or truncate) a file with the header for size elements of type and map it for writing */
+    dataset_file(std::string const &path, element_type const &type, std::size_t const &size);
+
+    ~dataset_file();
+
+    dataset_file(dataset_file const &)            = delete;
+    dataset_file &operator=(dataset_file const &) = delete;
+
+    element_type get_type() const;
+
+    /* Elements */
+    std::size_t get_size() const;
+
+    bool has_header() const;
+
+    /* Is path this file (the same device and inode, so links and other spellings of the path count too) */
+    bool is_same_file(std::string const &path) const;
+
+    /* The elements, the mapping of an input file is read-only */
+    template<typename data_type>
+    data_type *data() const;
+
+    /* Write the mapped pages of an output file back */
+    void sync();
+
+    /* Bytes per element of type */
+    static std::size_t get_element_size(element_type const &type);
+
+private:
+    std::string path;
+    void *mapping            = nullptr;
+    std::size_t mapping_size = 0;
+    std::size_t offset       = 0;
+    std::size_t size         = 0;
+    element_type type        = ELEMENT_FLOAT;
+    bool header              = false;
+    bool writable            = false;
+    std::uint64_t device     = 0;
+    std::uint64_t inode      = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename data_type>
+data_type *dataset_file::data() const
+{
+    if(sizeof(data_type) != get_element_size(type))
+    {
+        throw std::logic_error("The element type doesn't match the dataset: " + path);
+    }
+
+    return reinterpret_cast<data_type *>(static_cast<char *>(mapping) + offset);
+}
+
+#endif // IO_DATASET_FILE_H
@@ -149,4 +149,9 @@ void kernel_loader::load()
     load("log_vector_8");
     load("log_vector_4");
     load("log_vector_2");
+
+    load("square_vector_4");
+
+    load("roofline_copy");
+    load("roofline_flops");
 }
\ No newline at end of file
@@ -0,0 +1,202 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Chunks of float files read ahead on a reader thread
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "io/stream_reader.h"
+
+#include "core/execution_time.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+stream_reader::stream_reader(std::vector<std::string> const &paths, std::size_t const &chunk_size, std::size_t const &buffers)
+{
+    if(paths.empty() || (chunk_size == 0) || (buffers == 0))
+    {
+        throw std::invalid_argument("stream_reader needs files, a chunk size and buffers");
+    }
+
+    this->chunk_size = chunk_size;
+    this->size       = get_file_size(paths[0]);
+
+    for(std::string const &path : paths)
+    {
+        files.emplace_back(path, std::ios::binary);
+
+        if(!files.back())
+        {
+            throw std::runtime_error("Failed opening file: " + path);
+        }
+
+        size = std::min(size, get_file_size(path));
+    }
+
+    chunks.resize(buffers);
+
+    for(stream_chunk &chunk : chunks)
+    {
+        for(std::size_t f = 0; f < paths.size(); f++)
+        {
+            chunk.data.emplace_back(chunk_size);
+        }
+    }
+
+    reader = std::thread(&stream_reader::read, this);
+}
+
+stream_reader::~stream_reader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+
+    freed.notify_all();
+    reader.join();
+}
+
+std::size_t stream_reader::get_size() const
+{
+    return size;
+}
+
+stream_chunk const *stream_reader::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    execution_time et;
+    et.start();
+
+    ready.wait(
+        lock,
+        [&]
+        {
+            return (head < tail) || done;
+        });
+
+    et.stop();
+
+    wait_seconds += static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    if(head == tail)
+    {
+        return nullptr;
+    }
+
+    return &chunks[head % chunks.size()];
+}
+
+void stream_reader::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        head++;
+    }
+
+    freed.notify_one();
+}
+
+double stream_reader::get_wait_seconds() const
+{
+    return wait_seconds;
+}
+
+std::size_t stream_reader::get_file_size(std::string const &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if(!file)
+    {
+        return 0;
+    }
+
+    return static_cast<std::size_t>(file.tellg()) / sizeof(float);
+}
+
+void stream_reader::read()
+{
+    try
+    {
+        for(std::size_t offset = 0; offset < size; offset += chunk_size)
+        {
+            stream_chunk *chunk = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                /* Wait for a chunk the consumer has released */
+                freed.wait(
+                    lock,
+                    [&]
+                    {
+                        return stop || ((tail - head) < chunks.size());
+                    });
+
+                if(stop)
+                {
+                    return;
+                }
+
+                chunk = &chunks[tail % chunks.size()];
+            }
+
+            /* The chunk is not shared until tail moves */
+            chunk->offset = offset;
+            chunk->count  = std::min(chunk_size, size - offset);
+
+            for(std::size_t f = 0; f < files.size(); f++)
+            {
+                if(!files[f].read(reinterpret_cast<char *>(chunk->data[f].data()), chunk->count * sizeof(float)))
+                {
+                    throw std::runtime_error("Failed reading a stream file");
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tail++;
+            }
+
+            ready.notify_one();
+        }
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+
+    ready.notify_one();
+}
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Chunks of float files read ahead on a reader thread
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef IO_STREAM_READER_H
+#define IO_STREAM_READER_H
+
+#include "core/huge_page_allocator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* count elements of every file starting at element offset, data[f] holds file f */
+struct stream_chunk
+{
+    std::size_t offset = 0;
+    std::size_t count  = 0;
+    std::vector<huge_page_vector<float>> data;
+};
+
+/*
+    Reads raw float files chunk by chunk on its own thread. There are buffers
+    chunks (2: double buffering), the reader fills the next ones while the
+    consumer works on the current one, so reading overlaps the computation.
+    Every file is read in the same chunks, the shortest file sets the size.
+    Errors of the reader thread are rethrown by acquire()
+*/
+class stream_reader
+{
+public:
+    stream_reader(std::vector<std::string> const &paths, std::size_t const &chunk_size, std::size_t const &buffers = 2);
+    ~stream_reader();
+
+    stream_reader(stream_reader const &)            = delete;
+    stream_reader &operator=(stream_reader const &) = delete;
+
+    /* Elements read from every file */
+    std::size_t get_size() const;
+
+    /* Wait for the next chunk, nullptr after the last one. The chunk is valid until release() */
+    stream_chunk const *acquire();
+
+    /* Give the chunk of the last acquire() back to the reader thread */
+    void release();
+
+    /* Time acquire() waited for the reader thread (the consumer is faster than the files) */
+    double get_wait_seconds() const;
+
+    /* Elements of float in the file, 0 if it can't be opened */
+    static std::size_t get_file_size(std::string const &path);
+
+private:
+    /* Body of the reader thread */
+    void read();
+
+    std::vector<std::ifstream> files;
+    std::vector<stream_chunk> chunks;
+    std::size_t size       = 0;
+    std::size_t chunk_size = 0;
+
+    /* Chunks consumed and chunks read, chunk n is in chunks[n % chunks.size()] */
+    std::size_t head = 0;
+    std::size_t tail = 0;
+
+    bool done = false;
+    bool stop = false;
+    std::exception_ptr error;
+    double wait_seconds = 0;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable freed;
+    std::thread reader;
+};
+
+#endif // IO_STREAM_READER_H
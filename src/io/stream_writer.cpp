@@ -0,0 +1,163 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Chunks of a float file written back on a writer thread
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "io/stream_writer.h"
+
+#include <stdexcept>
+
+stream_writer::stream_writer(std::string const &path, std::size_t const &chunk_size, std::size_t const &buffers)
+{
+    if((chunk_size == 0) || (buffers == 0))
+    {
+        throw std::invalid_argument("stream_writer needs a chunk size and buffers");
+    }
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+
+    if(!file)
+    {
+        throw std::runtime_error("Failed opening file: " + path);
+    }
+
+    for(std::size_t n = 0; n < buffers; n++)
+    {
+        this->buffers.emplace_back(chunk_size);
+    }
+
+    counts.resize(buffers);
+
+    writer = std::thread(&stream_writer::write, this);
+}
+
+stream_writer::~stream_writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+
+    committed.notify_all();
+    writer.join();
+}
+
+float *stream_writer::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    wait(
+        lock,
+        [&]
+        {
+            return (tail - head) < buffers.size();
+        });
+
+    return buffers[tail % buffers.size()].data();
+}
+
+void stream_writer::commit(std::size_t const &count)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counts[tail % buffers.size()] = count;
+        tail++;
+    }
+
+    committed.notify_one();
+}
+
+void stream_writer::finish()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    wait(
+        lock,
+        [&]
+        {
+            return head == tail;
+        });
+
+    if(!file.flush())
+    {
+        throw std::runtime_error("Failed writing a stream file");
+    }
+}
+
+double stream_writer::get_wait_seconds() const
+{
+    return wait_seconds;
+}
+
+void stream_writer::write()
+{
+    try
+    {
+        while(true)
+        {
+            std::size_t slot;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                /* Committed chunks are written before the thread stops */
+                committed.wait(
+                    lock,
+                    [&]
+                    {
+                        return stop || (head < tail);
+                    });
+
+                if(head == tail)
+                {
+                    return;
+                }
+
+                slot = head % buffers.size();
+            }
+
+            /* The buffer is not reused until head moves */
+            if(!file.write(reinterpret_cast<char const *>(buffers[slot].data()), counts[slot] * sizeof(float)))
+            {
+                throw std::runtime_error("Failed writing a stream file");
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                head++;
+            }
+
+            written.notify_all();
+        }
+    }
+    catch(...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+        }
+
+        written.notify_all();
+    }
+}
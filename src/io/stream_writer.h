@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Chunks of a float file written back on a writer thread
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef IO_STREAM_WRITER_H
+#define IO_STREAM_WRITER_H
+
+#include "core/execution_time.h"
+#include "core/huge_page_allocator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    Writes a raw float file chunk by chunk on its own thread. The producer
+    fills one of buffers chunks (2: double buffering) and commits it, the
+    writer thread appends committed chunks to the file in order while the
+    producer fills the next one. Errors of the writer thread are rethrown
+    by acquire() and finish()
+*/
+class stream_writer
+{
+public:
+    stream_writer(std::string const &path, std::size_t const &chunk_size, std::size_t const &buffers = 2);
+    ~stream_writer();
+
+    stream_writer(stream_writer const &)            = delete;
+    stream_writer &operator=(stream_writer const &) = delete;
+
+    /* A buffer of chunk_size elements, waits for the writer thread while every buffer is committed */
+    float *acquire();
+
+    /* Append count elements of the buffer of the last acquire() to the file */
+    void commit(std::size_t const &count);
+
+    /* Wait until every committed chunk is written and flushed */
+    void finish();
+
+    /* Time acquire() and finish() waited for the writer thread (the producer is faster than the file) */
+    double get_wait_seconds() const;
+
+private:
+    /* Body of the writer thread */
+    void write();
+
+    /* Wait (with the lock held) until predicate is true or the writer failed, and count the time */
+    template<typename predicate_type>
+    void wait(std::unique_lock<std::mutex> &lock, predicate_type const &predicate);
+
+    std::ofstream file;
+    std::vector<huge_page_vector<float>> buffers;
+    std::vector<std::size_t> counts;
+
+    /* Chunks written and chunks committed, chunk n is in buffers[n % buffers.size()] */
+    std::size_t head = 0;
+    std::size_t tail = 0;
+
+    bool stop = false;
+    std::exception_ptr error;
+    double wait_seconds = 0;
+
+    std::mutex mutex;
+    std::condition_variable committed;
+    std::condition_variable written;
+    std::thread writer;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename predicate_type>
+void stream_writer::wait(std::unique_lock<std::mutex> &lock, predicate_type const &predicate)
+{
+    execution_time et;
+    et.start();
+
+    written.wait(
+        lock,
+        [&]
+        {
+            return predicate() || error;
+        });
+
+    et.stop();
+
+    wait_seconds += static_cast<double>(et.count_nanoseconds()) / 1e9;
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif // IO_STREAM_WRITER_H
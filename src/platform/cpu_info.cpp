@@ -0,0 +1,220 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Information about the host processor
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "platform/cpu_info.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+    #define NYX_CPU_INFO_X86
+#endif
+
+cpu_info::cpu_info()
+{
+#ifdef NYX_CPU_INFO_X86
+    /*
+        __builtin_cpu_supports also checks that the OS saves the extended
+        registers (XGETBV), so AVX/AVX-512 are reported only when usable
+    */
+    __builtin_cpu_init();
+
+    sse2    = __builtin_cpu_supports("sse2");
+    avx     = __builtin_cpu_supports("avx");
+    avx2    = __builtin_cpu_supports("avx2");
+    fma     = __builtin_cpu_supports("fma");
+    f16c    = __builtin_cpu_supports("f16c");
+    avx512f = __builtin_cpu_supports("avx512f");
+
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    if(__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && (eax >= 0x80000004))
+    {
+        char buffer[49] = {0};
+
+        for(unsigned int leaf = 0; leaf < 3; leaf++)
+        {
+            __get_cpuid(0x80000002 + leaf, &eax, &ebx, &ecx, &edx);
+
+            unsigned int registers[4] = {eax, ebx, ecx, edx};
+            for(unsigned int r = 0; r < 4; r++)
+            {
+                for(unsigned int b = 0; b < 4; b++)
+                {
+                    buffer[(leaf * 16) + (r * 4) + b] = static_cast<char>((registers[r] >> (b * 8)) & 0xFF);
+                }
+            }
+        }
+
+        brand = buffer;
+
+        /* Brand string is padded with spaces */
+        std::size_t first = brand.find_first_not_of(' ');
+        brand             = (first == std::string::npos) ? "" : brand.substr(first);
+    }
+
+    detect_caches();
+#endif
+}
+
+void cpu_info::detect_caches()
+{
+#ifdef NYX_CPU_INFO_X86
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    /*
+        Deterministic cache parameters: leaf 4 on Intel, leaf 0x8000001D on AMD
+        (with topology extensions). Both have the same layout, one subleaf per cache
+    */
+    unsigned int leaf = 4;
+
+    if(!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+    {
+        return;
+    }
+
+    unsigned int max_leaf = eax;
+
+    /* "AuthenticAMD" and "HygonGenuine", ebx holds the first four characters */
+    bool amd = (ebx == 0x68747541) || (ebx == 0x6F677948);
+
+    if(amd)
+    {
+        if(!__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 22)))
+        {
+            return;
+        }
+
+        leaf = 0x8000001D;
+    }
+    else if(max_leaf < 4)
+    {
+        return;
+    }
+
+    for(unsigned int subleaf = 0; subleaf < 16; subleaf++)
+    {
+        __cpuid_count(leaf, subleaf, eax, ebx, ecx, edx);
+
+        /* 0 - no more caches, 1 - data, 2 - instruction, 3 - unified */
+        unsigned int type = eax & 0x1F;
+
+        if(type == 0)
+        {
+            break;
+        }
+
+        if(type == 2)
+        {
+            continue;
+        }
+
+        std::size_t ways       = ((ebx >> 22) & 0x3FF) + 1;
+        std::size_t partitions = ((ebx >> 12) & 0x3FF) + 1;
+        std::size_t line_size  = (ebx & 0xFFF) + 1;
+        std::size_t sets       = static_cast<std::size_t>(ecx) + 1;
+        std::size_t size       = ways * partitions * line_size * sets;
+
+        switch((eax >> 5) & 0x7)
+        {
+            case 1:
+                l1_cache_size = size;
+                break;
+            case 2:
+                l2_cache_size = size;
+                break;
+            case 3:
+                l3_cache_size = size;
+                break;
+            default:
+                break;
+        }
+    }
+#endif
+}
+
+bool cpu_info::has_sse2() const
+{
+    return sse2;
+}
+
+bool cpu_info::has_avx() const
+{
+    return avx;
+}
+
+bool cpu_info::has_avx2() const
+{
+    return avx2;
+}
+
+bool cpu_info::has_fma() const
+{
+    return fma;
+}
+
+bool cpu_info::has_f16c() const
+{
+    return f16c;
+}
+
+bool cpu_info::has_avx512f() const
+{
+    return avx512f;
+}
+
+std::string const &cpu_info::get_brand() const
+{
+    return brand;
+}
+
+std::size_t cpu_info::get_l1_cache_size() const
+{
+    return l1_cache_size;
+}
+
+std::size_t cpu_info::get_l2_cache_size() const
+{
+    return l2_cache_size;
+}
+
+std::size_t cpu_info::get_l3_cache_size() const
+{
+    return l3_cache_size;
+}
+
+std::size_t cpu_info::get_last_level_cache_size() const
+{
+    if(l3_cache_size != 0)
+        return l3_cache_size;
+    if(l2_cache_size != 0)
+        return l2_cache_size;
+    return l1_cache_size;
+}
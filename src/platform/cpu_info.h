@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Information about the host processor
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef PLATFORM_CPU_INFO_H
+#define PLATFORM_CPU_INFO_H
+
+#include <cstddef>
+#include <string>
+
+class cpu_info
+{
+public:
+    /* Class */
+    static cpu_info &instance()
+    {
+        static cpu_info ci;
+        return ci;
+    }
+
+    /* Instruction set extensions (supported by the processor and enabled by the OS) */
+    bool has_sse2() const;
+    bool has_avx() const;
+    bool has_avx2() const;
+    bool has_fma() const;
+    bool has_f16c() const;
+    bool has_avx512f() const;
+
+    /* Processor brand string (empty if unknown) */
+    std::string const &get_brand() const;
+
+    /* Data/unified cache sizes in bytes (0 if unknown) */
+    std::size_t get_l1_cache_size() const;
+    std::size_t get_l2_cache_size() const;
+    std::size_t get_l3_cache_size() const;
+
+    /* Size of the largest detected cache level in bytes (0 if unknown) */
+    std::size_t get_last_level_cache_size() const;
+
+private:
+    /* Class */
+    cpu_info();
+    cpu_info(cpu_info const &)            = delete;
+    cpu_info &operator=(cpu_info const &) = delete;
+
+    void detect_caches();
+
+    /* Variables */
+    bool sse2    = false;
+    bool avx     = false;
+    bool avx2    = false;
+    bool fma     = false;
+    bool f16c    = false;
+    bool avx512f = false;
+    std::string brand;
+    std::size_t l1_cache_size = 0;
+    std::size_t l2_cache_size = 0;
+    std::size_t l3_cache_size = 0;
+};
+
+#endif // PLATFORM_CPU_INFO_H
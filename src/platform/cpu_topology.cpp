@@ -0,0 +1,357 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Logical CPUs, cores, packages and NUMA nodes of the process, thread pinning and page placement
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "platform/cpu_topology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <climits>
+    #define NYX_CPU_TOPOLOGY_LINUX
+#endif
+
+namespace
+{
+    /* Larger ids in a cpulist are rejected */
+    std::size_t const max_cpu_id = 65535;
+
+    bool is_number(std::string const &text)
+    {
+        return !text.empty() && (text.size() <= 5) && (text.find_first_not_of("0123456789") == std::string::npos);
+    }
+
+#ifdef NYX_CPU_TOPOLOGY_LINUX
+    /* From linux/mempolicy.h */
+    int const mpol_preferred = 1;
+
+    std::string read_line(std::string const &path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    std::size_t read_number(std::string const &path, std::size_t const &fallback)
+    {
+        std::string line = read_line(path);
+
+        if(line.empty() || (line.find_first_not_of("0123456789") != std::string::npos))
+        {
+            return fallback;
+        }
+
+        return std::stoul(line);
+    }
+
+    bool pin(pthread_t const &thread, std::size_t const &cpu)
+    {
+        if(cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+    }
+#endif
+} // namespace
+
+cpu_topology::cpu_topology()
+{
+#ifdef NYX_CPU_TOPOLOGY_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(std::size_t id = 0; id < CPU_SETSIZE; id++)
+        {
+            if(!CPU_ISSET(id, &set))
+            {
+                continue;
+            }
+
+            std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+
+            logical_cpu cpu;
+            cpu.id      = id;
+            cpu.package = read_number(path + "physical_package_id", 0);
+
+            /* Without topology every logical CPU is a core of its own */
+            cpu.core = read_number(path + "core_id", id);
+
+            cpus.push_back(cpu);
+        }
+    }
+
+    detect_nodes();
+#endif
+
+    if(cpus.empty())
+    {
+        std::size_t count = std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+
+        for(std::size_t id = 0; id < count; id++)
+        {
+            logical_cpu cpu;
+            cpu.id   = id;
+            cpu.core = id;
+            cpus.push_back(cpu);
+        }
+    }
+}
+
+void cpu_topology::detect_nodes()
+{
+#ifdef NYX_CPU_TOPOLOGY_LINUX
+    DIR *directory = opendir("/sys/devices/system/node");
+
+    if(directory == nullptr)
+    {
+        return;
+    }
+
+    std::vector<std::size_t> nodes;
+
+    while(dirent *entry = readdir(directory))
+    {
+        std::string name = entry->d_name;
+
+        if((name.size() > 4) && (name.compare(0, 4, "node") == 0) && (name.find_first_not_of("0123456789", 4) == std::string::npos))
+        {
+            std::size_t node = std::stoul(name.substr(4));
+
+            try
+            {
+                for(std::size_t const &id : parse_cpu_list(read_line("/sys/devices/system/node/" + name + "/cpulist")))
+                {
+                    for(logical_cpu &cpu : cpus)
+                    {
+                        if(cpu.id == id)
+                        {
+                            cpu.node = node;
+                        }
+                    }
+                }
+            }
+            catch(std::invalid_argument const &)
+            {
+                /* A node without CPUs has an empty cpulist */
+            }
+        }
+    }
+
+    closedir(directory);
+
+    for(logical_cpu const &cpu : cpus)
+    {
+        nodes.push_back(cpu.node);
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    node_count = std::max<std::size_t>(std::unique(nodes.begin(), nodes.end()) - nodes.begin(), 1);
+#endif
+}
+
+std::vector<cpu_topology::logical_cpu> const &cpu_topology::get_cpus() const
+{
+    return cpus;
+}
+
+std::size_t cpu_topology::get_node_count() const
+{
+    return node_count;
+}
+
+std::size_t cpu_topology::get_node(std::size_t const &cpu) const
+{
+    for(logical_cpu const &c : cpus)
+    {
+        if(c.id == cpu)
+        {
+            return c.node;
+        }
+    }
+
+    return 0;
+}
+
+std::vector<std::size_t> cpu_topology::get_compact_order() const
+{
+    std::vector<logical_cpu> sorted = cpus;
+
+    std::sort(
+        sorted.begin(),
+        sorted.end(),
+        [](logical_cpu const &a, logical_cpu const &b)
+        {
+            return std::tie(a.node, a.package, a.core, a.id) < std::tie(b.node, b.package, b.core, b.id);
+        });
+
+    std::vector<std::size_t> order;
+
+    for(logical_cpu const &cpu : sorted)
+    {
+        order.push_back(cpu.id);
+    }
+
+    return order;
+}
+
+std::vector<std::size_t> cpu_topology::get_scatter_order() const
+{
+    /* Rank of every CPU: its hardware thread in the core, the core in the node and the node */
+    std::map<std::pair<std::size_t, std::size_t>, std::size_t> threads_of_core;
+    std::map<std::size_t, std::size_t> cores_of_node;
+    std::map<std::pair<std::size_t, std::size_t>, std::size_t> core_rank;
+    std::map<std::size_t, std::size_t> node_rank;
+
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t, std::size_t>> keys;
+
+    for(std::size_t const &id : get_compact_order())
+    {
+        logical_cpu const *cpu = nullptr;
+
+        for(logical_cpu const &c : cpus)
+        {
+            if(c.id == id)
+            {
+                cpu = &c;
+            }
+        }
+
+        std::pair<std::size_t, std::size_t> core(cpu->package, cpu->core);
+
+        if(node_rank.find(cpu->node) == node_rank.end())
+        {
+            std::size_t rank     = node_rank.size();
+            node_rank[cpu->node] = rank;
+        }
+
+        if(core_rank.find(core) == core_rank.end())
+        {
+            core_rank[core] = cores_of_node[cpu->node]++;
+        }
+
+        keys.emplace_back(threads_of_core[core]++, core_rank[core], node_rank[cpu->node], cpu->id);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::size_t> order;
+
+    for(auto const &key : keys)
+    {
+        order.push_back(std::get<3>(key));
+    }
+
+    return order;
+}
+
+bool cpu_topology::pin_current_thread(std::size_t const &cpu)
+{
+#ifdef NYX_CPU_TOPOLOGY_LINUX
+    return pin(pthread_self(), cpu);
+#else
+    return false;
+#endif
+}
+
+bool cpu_topology::pin_thread(std::thread &thread, std::size_t const &cpu)
+{
+#ifdef NYX_CPU_TOPOLOGY_LINUX
+    return pin(thread.native_handle(), cpu);
+#else
+    return false;
+#endif
+}
+
+bool cpu_topology::bind_memory(void *pointer, std::size_t const &bytes, std::size_t const &node)
+{
+#if defined(NYX_CPU_TOPOLOGY_LINUX) && defined(SYS_mbind)
+    /* mbind reads maxnode - 1 bits of the mask */
+    std::size_t bits = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> mask((node / bits) + 1, 0);
+    mask[node / bits] |= 1ul << (node % bits);
+
+    return syscall(SYS_mbind, pointer, bytes, mpol_preferred, mask.data(), (mask.size() * bits) + 1, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<std::size_t> cpu_topology::parse_cpu_list(std::string const &list)
+{
+    std::vector<std::size_t> result;
+    std::size_t begin = 0;
+
+    while(begin <= list.size())
+    {
+        std::size_t end  = std::min(list.find(',', begin), list.size());
+        std::string item = list.substr(begin, end - begin);
+        std::size_t dash = item.find('-');
+
+        std::string first = item.substr(0, dash);
+        std::string last  = (dash == std::string::npos) ? first : item.substr(dash + 1);
+
+        if(!is_number(first) || !is_number(last))
+        {
+            throw std::invalid_argument("Invalid cpu list: " + list);
+        }
+
+        std::size_t from = std::stoul(first);
+        std::size_t to   = std::stoul(last);
+
+        if((to < from) || (to > max_cpu_id))
+        {
+            throw std::invalid_argument("Invalid cpu list: " + list);
+        }
+
+        for(std::size_t cpu = from; cpu <= to; cpu++)
+        {
+            result.push_back(cpu);
+        }
+
+        begin = end + 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Logical CPUs, cores, packages and NUMA nodes of the process, thread pinning and page placement
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef PLATFORM_CPU_TOPOLOGY_H
+#define PLATFORM_CPU_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    The topology is read once (Linux: sched_getaffinity and sysfs), before
+    any thread is pinned, so it covers every CPU the process was started on.
+    Elsewhere it is a single node with std::thread::hardware_concurrency()
+    CPUs and pinning is not supported.
+*/
+class cpu_topology
+{
+public:
+    /* Class */
+    static cpu_topology &instance()
+    {
+        static cpu_topology ct;
+        return ct;
+    }
+
+    struct logical_cpu
+    {
+        std::size_t id      = 0;
+        std::size_t package = 0;
+        std::size_t core    = 0;
+        std::size_t node    = 0;
+    };
+
+    /* Logical CPUs the process may run on, ordered by id */
+    std::vector<logical_cpu> const &get_cpus() const;
+
+    /* Count of NUMA nodes with CPUs of the process */
+    std::size_t get_node_count() const;
+
+    /* NUMA node of the logical CPU (0 if unknown) */
+    std::size_t get_node(std::size_t const &cpu) const;
+
+    /* Hardware threads of a core next to each other, then the next core of the same package and node */
+    std::vector<std::size_t> get_compact_order() const;
+
+    /* One hardware thread per core, alternating between the nodes, the other hardware threads of the cores last */
+    std::vector<std::size_t> get_scatter_order() const;
+
+    /* Pin a thread to a logical CPU, false if it failed or is not supported */
+    static bool pin_current_thread(std::size_t const &cpu);
+    static bool pin_thread(std::thread &thread, std::size_t const &cpu);
+
+    /*
+        Prefer the NUMA node for the pages of [pointer, pointer + bytes), pointer must
+        be page aligned. The pages go to the node whoever touches them first, other
+        nodes are used only if it is full. false if it failed or is not supported
+    */
+    static bool bind_memory(void *pointer, std::size_t const &bytes, std::size_t const &node);
+
+    /* Parse a cpulist like "0-3,8,10-11" (throws std::invalid_argument) */
+    static std::vector<std::size_t> parse_cpu_list(std::string const &list);
+
+private:
+    /* Class */
+    cpu_topology();
+    cpu_topology(cpu_topology const &)            = delete;
+    cpu_topology &operator=(cpu_topology const &) = delete;
+
+    void detect_nodes();
+
+    /* Variables */
+    std::vector<logical_cpu> cpus;
+    std::size_t node_count = 1;
+};
+
+#endif // PLATFORM_CPU_TOPOLOGY_H
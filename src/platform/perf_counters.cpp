@@ -0,0 +1,224 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Hardware and software event counters of the process
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#include "platform/perf_counters.h"
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <cstdlib>
+    #include <cstring>
+    #define NYX_PERF_COUNTERS_LINUX
+#endif
+
+namespace
+{
+#ifdef NYX_PERF_COUNTERS_LINUX
+    perf_event_attr get_attributes(perf_counters::event const &e)
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+
+        attributes.size           = sizeof(attributes);
+        attributes.disabled       = 1;
+        attributes.inherit        = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+
+        switch(e)
+        {
+            case perf_counters::DTLB_LOAD_MISSES:
+                attributes.type   = PERF_TYPE_HW_CACHE;
+                attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case perf_counters::DTLB_STORE_MISSES:
+                attributes.type   = PERF_TYPE_HW_CACHE;
+                attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_WRITE << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case perf_counters::PAGE_FAULTS:
+            default:
+                attributes.type   = PERF_TYPE_SOFTWARE;
+                attributes.config = PERF_COUNT_SW_PAGE_FAULTS;
+                break;
+        }
+
+        return attributes;
+    }
+
+    /* Thread ids of the process, counters are per thread */
+    std::vector<pid_t> get_threads()
+    {
+        std::vector<pid_t> threads;
+
+        DIR *directory = opendir("/proc/self/task");
+
+        if(directory == nullptr)
+        {
+            threads.push_back(0);
+            return threads;
+        }
+
+        while(dirent *entry = readdir(directory))
+        {
+            if(entry->d_name[0] != '.')
+            {
+                threads.push_back(static_cast<pid_t>(std::atoi(entry->d_name)));
+            }
+        }
+
+        closedir(directory);
+
+        return threads;
+    }
+#endif
+} // namespace
+
+perf_counters::~perf_counters()
+{
+    close();
+}
+
+void perf_counters::start()
+{
+    close();
+
+    values.fill(0);
+    available.fill(false);
+
+#ifdef NYX_PERF_COUNTERS_LINUX
+    std::vector<pid_t> threads = get_threads();
+
+    for(std::size_t e = 0; e < EVENT_COUNT; e++)
+    {
+        perf_event_attr attributes = get_attributes(static_cast<event>(e));
+
+        for(pid_t const &thread : threads)
+        {
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, thread, -1, -1, 0));
+
+            if(fd != -1)
+            {
+                descriptors[e].push_back(fd);
+            }
+        }
+
+        available[e] = !descriptors[e].empty();
+    }
+
+    for(auto const &fds : descriptors)
+    {
+        for(int const &fd : fds)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void perf_counters::stop()
+{
+#ifdef NYX_PERF_COUNTERS_LINUX
+    for(std::size_t e = 0; e < EVENT_COUNT; e++)
+    {
+        for(int const &fd : descriptors[e])
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            std::uint64_t value = 0;
+
+            if(read(fd, &value, sizeof(value)) == sizeof(value))
+            {
+                values[e] += value;
+            }
+        }
+    }
+#endif
+
+    close();
+}
+
+bool perf_counters::is_available(event const &e) const
+{
+    return available[e];
+}
+
+std::uint64_t perf_counters::get(event const &e) const
+{
+    return values[e];
+}
+
+std::string perf_counters::get_event_name(event const &e)
+{
+    switch(e)
+    {
+        case DTLB_LOAD_MISSES:
+            return "dTLB load misses";
+        case DTLB_STORE_MISSES:
+            return "dTLB store misses";
+        case PAGE_FAULTS:
+            return "page faults";
+        default:
+            return "unknown event";
+    }
+}
+
+std::string perf_counters::to_string() const
+{
+    std::string result;
+
+    for(std::size_t e = 0; e < EVENT_COUNT; e++)
+    {
+        if(!result.empty())
+        {
+            result += ", ";
+        }
+
+        result += get_event_name(static_cast<event>(e)) + " ";
+        result += available[e] ? std::to_string(values[e]) : "n/a";
+    }
+
+    return result;
+}
+
+void perf_counters::close()
+{
+#ifdef NYX_PERF_COUNTERS_LINUX
+    for(auto &fds : descriptors)
+    {
+        for(int const &fd : fds)
+        {
+            ::close(fd);
+        }
+
+        fds.clear();
+    }
+#endif
+}
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2022-2024 Savelii Pototskii (savalione.com)
+ * All rights reserved.
+ *
+ * Author: Savelii Pototskii <monologuesplus@gmail.com>
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file
+ * @brief Hardware and software event counters of the process
+ * @author Savelii Pototskii (savalione.com)
+ * @date 17 Oct 2026
+ */
+#ifndef PLATFORM_PERF_COUNTERS_H
+#define PLATFORM_PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+    Counts events of every thread of the process between start() and stop()
+    (perf_event_open on Linux). Events the system doesn't expose (hardware
+    counters in virtual machines, perf_event_paranoid, other systems) are
+    reported as unavailable.
+*/
+class perf_counters
+{
+public:
+    enum event
+    {
+        DTLB_LOAD_MISSES,
+        DTLB_STORE_MISSES,
+        PAGE_FAULTS,
+        EVENT_COUNT
+    };
+
+    perf_counters() = default;
+    ~perf_counters();
+
+    perf_counters(perf_counters const &)            = delete;
+    perf_counters &operator=(perf_counters const &) = delete;
+
+    void start();
+    void stop();
+
+    bool is_available(event const &e) const;
+    std::uint64_t get(event const &e) const;
+
+    static std::string get_event_name(event const &e);
+
+    /* "<name> <count>" of every event, "n/a" instead of the count if it isn't available */
+    std::string to_string() const;
+
+private:
+    void close();
+
+    /* Variables */
+    std::array<std::vector<int>, EVENT_COUNT> descriptors;
+    std::array<std::uint64_t, EVENT_COUNT> values = {};
+    std::array<bool, EVENT_COUNT> available       = {};
+};
+
+#endif // PLATFORM_PERF_COUNTERS_H